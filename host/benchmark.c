@@ -0,0 +1,568 @@
+/**
+ * @file benchmark.c
+ * @brief Benchmark of the bus cost of the MCP7940 driver API on the host platform.
+ *
+ * This file runs every public function of the MCP7940 driver a given number of times against the simulated MCP7940 of the host TWI/I2C hardware abstraction layer and prints the bus cost per call (transactions, start conditions, bytes on the wire, blocking delay, total bus time and EEPROM write cycles) as a CSV table. The numbers are used to plan the bus bandwidth when several peripherals share the bus with the RTC and to track the effect of optimizations.
+ *
+ * Functions of optional features are only benchmarked if the feature is enabled, so the benchmark is built once per configuration of interest, e.g. with @c MCP7940_IO_WAIT_NONE, @c MCP7940_SHADOW_EN, @c MCP7940_QUEUE_EN or a variant with EEPROM. Copied to the root of the library package, it is built and run with:
+ * @code
+ * gcc -std=c99 -DMCP7940_HAL_PLATFORM=host -I. -o benchmark benchmark.c drivers/rtc/mcp7940/mcp7940.c hal/host/twi/twi.c utils/time/validate.c
+ * ./benchmark 1000 > benchmark.csv
+ * @endcode
+ *
+ * @author g.raf
+ * @date 2026-10-14
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/drivers-rtc-mcp7940 "MCP7940 RTC driver library"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hal/host/twi/twi.h"
+#include "drivers/rtc/mcp7940/mcp7940.h"
+
+#ifndef BENCHMARK_CALLS
+    /**
+     * @def BENCHMARK_CALLS
+     * @brief Number of calls per function if no count is passed on the command line.
+     *
+     * @note If BENCHMARK_CALLS is not explicitly defined in the project configuration, it defaults to 100.
+     */
+    #define BENCHMARK_CALLS 100UL
+#endif
+
+/**
+ * @struct BENCHMARK_Case_t
+ * @brief Function under test with the name printed in the table.
+ */
+struct BENCHMARK_Case_t
+{
+    const char *name;                   /**< Name of the public function */
+    MCP7940_Error (*run)(void);         /**< Executes one call of the function */
+    void (*prepare)(void);              /**< Executed before every call and not measured (may be 0) */
+};
+/**
+ * @typedef BENCHMARK_Case
+ * @brief Alias for struct BENCHMARK_Case_t.
+ */
+typedef struct BENCHMARK_Case_t BENCHMARK_Case;
+
+// 14.10.2026 12:30:00 (Unix time 1791981000)
+static const FORMAT_DateTime benchmark_reference = {
+    { 14, 10, 26 },
+    { 12, 30, 0 }
+};
+
+static unsigned char benchmark_sram[8] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
+
+#ifdef MCP7940_HAS_EEPROM
+    // Starts in the middle of a page, so a write is split into three pages
+    #define BENCHMARK_EEPROM_ADDRESS 0x04
+    #define BENCHMARK_EEPROM_LENGTH  16
+
+    static unsigned char benchmark_eeprom[BENCHMARK_EEPROM_LENGTH];
+#endif
+
+/**
+ * @brief Delay hook of the driver, implemented with the simulated clock.
+ *
+ * @param ms Delay in milliseconds.
+ */
+void systick_timer_wait_ms(unsigned int ms)
+{
+    twi_host_wait_ms(ms);
+}
+
+#ifdef MCP7940_CALIBRATION_EN
+    static unsigned long benchmark_ms(void)
+    {
+        return (twi_host_statistics.time_us / 1000UL);
+    }
+#endif
+
+static MCP7940_Error benchmark_init(void)
+{
+    return mcp7940_init();
+}
+
+static MCP7940_Error benchmark_status(void)
+{
+    (void)mcp7940_status();
+    return MCP7940_Error_None;
+}
+
+static MCP7940_Error benchmark_weekday(void)
+{
+    (void)mcp7940_weekday(MCP7940_Register_Current_Time);
+    return MCP7940_Error_None;
+}
+
+static MCP7940_Error benchmark_leapyear(void)
+{
+    (void)mcp7940_leapyear();
+    return MCP7940_Error_None;
+}
+
+static MCP7940_Error benchmark_time(void)
+{
+    FORMAT_Time time;
+    return mcp7940_time(&time, MCP7940_Register_Current_Time);
+}
+
+static MCP7940_Error benchmark_date(void)
+{
+    FORMAT_Date date;
+    return mcp7940_date(&date, MCP7940_Register_Current_Time);
+}
+
+static MCP7940_Error benchmark_datetime(void)
+{
+    FORMAT_DateTime datetime;
+    return mcp7940_datetime(&datetime, MCP7940_Register_Current_Time);
+}
+
+static MCP7940_Error benchmark_datetime_atomic(void)
+{
+    FORMAT_DateTime datetime;
+    return mcp7940_datetime_atomic(&datetime);
+}
+
+static MCP7940_Error benchmark_snapshot(void)
+{
+    MCP7940_Snapshot snapshot;
+    return mcp7940_snapshot(&snapshot);
+}
+
+static MCP7940_Error benchmark_snapshot_atomic(void)
+{
+    MCP7940_Snapshot snapshot;
+    return mcp7940_snapshot_atomic(&snapshot);
+}
+
+static MCP7940_Error benchmark_epoch(void)
+{
+    unsigned long epoch;
+    return mcp7940_epoch(&epoch);
+}
+
+static MCP7940_Error benchmark_settime(void)
+{
+    return mcp7940_settime(&benchmark_reference.time);
+}
+
+static MCP7940_Error benchmark_setweekday(void)
+{
+    return mcp7940_setweekday(MCP7940_WEEKDAY_WEDNESDAY_gc);
+}
+
+static MCP7940_Error benchmark_setdate(void)
+{
+    return mcp7940_setdate(&benchmark_reference.date);
+}
+
+static MCP7940_Error benchmark_setdatetime(void)
+{
+    return mcp7940_setdatetime(&benchmark_reference);
+}
+
+static MCP7940_Error benchmark_setepoch(void)
+{
+    return mcp7940_setepoch(1791981000UL);
+}
+
+static MCP7940_Error benchmark_trimming(void)
+{
+    return mcp7940_trimming(MCP7940_Trim_Add, 0x10);
+}
+
+static MCP7940_Error benchmark_oscillator(void)
+{
+    return mcp7940_oscillator(MCP7940_Mode_Enable);
+}
+
+static MCP7940_Error benchmark_oscillator_start(void)
+{
+    unsigned int elapsed;
+    return mcp7940_oscillator_start(MCP7940_OSC_ENABLE_MS, &elapsed);
+}
+
+#if MCP7940_MFP_MODE == MCP7940_MFP_MODE_OUTPUT
+    static MCP7940_Error benchmark_mfp_output(void)
+    {
+        return mcp7940_mfp_output(MCP7940_Mode_Enable);
+    }
+#endif
+
+#ifdef MCP7940_BATTERY_BACKUP_EN
+    static void benchmark_powerfail(void)
+    {
+        twi_host_powerfail(60UL);
+    }
+
+    static MCP7940_Error benchmark_powerfail_read(void)
+    {
+        MCP7940_PowerFail powerfail;
+        return mcp7940_powerfail_read(&powerfail);
+    }
+#endif
+
+static MCP7940_Error benchmark_alarm_set(void)
+{
+    return mcp7940_alarm_set(MCP7940_Alarm_0, &benchmark_reference, 1, MCP7940_Match_Full);
+}
+
+static MCP7940_Error benchmark_alarm_get(void)
+{
+    FORMAT_DateTime datetime;
+    unsigned char weekday;
+    MCP7940_Match match;
+
+    return mcp7940_alarm_get(MCP7940_Alarm_0, &datetime, &weekday, &match);
+}
+
+static MCP7940_Error benchmark_alarm_enable(void)
+{
+    return mcp7940_alarm_enable(MCP7940_Alarm_0, MCP7940_Mode_Enable);
+}
+
+static MCP7940_Error benchmark_alarm_clear(void)
+{
+    return mcp7940_alarm_clear(MCP7940_Alarm_0);
+}
+
+static MCP7940_Error benchmark_alarm_pending(void)
+{
+    (void)mcp7940_alarm_pending(MCP7940_Alarm_0);
+    return MCP7940_Error_None;
+}
+
+static MCP7940_Error benchmark_sram_read(void)
+{
+    return mcp7940_sram_read(0, benchmark_sram, sizeof(benchmark_sram));
+}
+
+static MCP7940_Error benchmark_sram_write(void)
+{
+    return mcp7940_sram_write(0, benchmark_sram, sizeof(benchmark_sram));
+}
+
+#ifdef MCP7940_HAS_EEPROM
+    static MCP7940_Error benchmark_eeprom_read(void)
+    {
+        return mcp7940_eeprom_read(BENCHMARK_EEPROM_ADDRESS, benchmark_eeprom, BENCHMARK_EEPROM_LENGTH);
+    }
+
+    static MCP7940_Error benchmark_eeprom_write(void)
+    {
+        return mcp7940_eeprom_write(BENCHMARK_EEPROM_ADDRESS, benchmark_eeprom, BENCHMARK_EEPROM_LENGTH);
+    }
+#endif
+
+#ifdef MCP7940_HAS_EUI
+    static MCP7940_Error benchmark_eui_read(void)
+    {
+        unsigned char eui[MCP7940_HAS_EUI];
+        return mcp7940_eui_read(eui);
+    }
+#endif
+
+#ifdef MCP7940_RECORD_EN
+    static MCP7940_Error benchmark_record_commit(void)
+    {
+        return mcp7940_record_commit(benchmark_sram);
+    }
+
+    static void benchmark_record(void)
+    {
+        mcp7940_record_commit(benchmark_sram);
+    }
+
+    static MCP7940_Error benchmark_record_restore(void)
+    {
+        return mcp7940_record_restore(benchmark_sram);
+    }
+#endif
+
+#ifdef MCP7940_CALIBRATION_EN
+    static void benchmark_window(void)
+    {
+        mcp7940_calibration_begin(benchmark_ms);
+        twi_host_elapse(1000000000UL);
+    }
+
+    static MCP7940_Error benchmark_calibration_begin(void)
+    {
+        return mcp7940_calibration_begin(benchmark_ms);
+    }
+
+    static MCP7940_Error benchmark_calibration_end(void)
+    {
+        long ppm;
+        return mcp7940_calibration_end(benchmark_ms, &ppm);
+    }
+
+    static void benchmark_calibration(void)
+    {
+        long ppm;
+
+        benchmark_window();
+        mcp7940_calibration_end(benchmark_ms, &ppm);
+    }
+
+    static MCP7940_Error benchmark_calibration_restore(void)
+    {
+        return mcp7940_calibration_restore();
+    }
+#endif
+
+#ifdef MCP7940_QUEUE_EN
+    static MCP7940_Status benchmark_queue_status;
+    static FORMAT_DateTime benchmark_queue_datetime;
+    static unsigned char benchmark_queue_trim;
+
+    static void benchmark_queue(void)
+    {
+        // Status, datetime and OSCTRIM are merged into one sequential read
+        mcp7940_queue_status(&benchmark_queue_status);
+        mcp7940_queue_datetime(&benchmark_queue_datetime);
+        mcp7940_queue_read(MCP7940_OSCTRIM, &benchmark_queue_trim, 1);
+        mcp7940_queue_write(MCP7940_SRAM, benchmark_sram, sizeof(benchmark_sram));
+    }
+
+    static MCP7940_Error benchmark_queue_flush(void)
+    {
+        unsigned char transactions;
+        return mcp7940_queue_flush(&transactions);
+    }
+#endif
+
+#ifdef MCP7940_TICK_EN
+    static MCP7940_Error benchmark_tick_sync(void)
+    {
+        return mcp7940_tick_sync();
+    }
+
+    #ifdef MCP7940_TICK_MS
+        static MCP7940_Error benchmark_tick_timestamp(void)
+        {
+            FORMAT_DateTime datetime;
+            unsigned int millisecond;
+
+            return mcp7940_tick_timestamp(&datetime, &millisecond);
+        }
+    #endif
+#endif
+
+#ifdef MCP7940_ASYNC_EN
+    static MCP7940_Error benchmark_async_error;
+
+    static void benchmark_async_done(MCP7940_Error error)
+    {
+        benchmark_async_error = error;
+    }
+
+    static MCP7940_Error benchmark_async_complete(MCP7940_Error error)
+    {
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+
+        while(mcp7940_async_busy())
+        {
+            mcp7940_async_poll();
+        }
+        return benchmark_async_error;
+    }
+
+    static MCP7940_Error benchmark_datetime_async(void)
+    {
+        static FORMAT_DateTime datetime;
+        return benchmark_async_complete(mcp7940_datetime_async(&datetime, benchmark_async_done));
+    }
+
+    static MCP7940_Error benchmark_settime_async(void)
+    {
+        return benchmark_async_complete(mcp7940_settime_async(&benchmark_reference.time, benchmark_async_done));
+    }
+
+    static MCP7940_Error benchmark_setdate_async(void)
+    {
+        return benchmark_async_complete(mcp7940_setdate_async(&benchmark_reference.date, benchmark_async_done));
+    }
+
+    static MCP7940_Error benchmark_sram_read_async(void)
+    {
+        return benchmark_async_complete(mcp7940_sram_read_async(0, benchmark_sram, sizeof(benchmark_sram), benchmark_async_done));
+    }
+
+    static MCP7940_Error benchmark_sram_write_async(void)
+    {
+        return benchmark_async_complete(mcp7940_sram_write_async(0, benchmark_sram, sizeof(benchmark_sram), benchmark_async_done));
+    }
+#endif
+
+static const BENCHMARK_Case benchmark_cases[] = {
+    { "mcp7940_init",                   benchmark_init,                 0 },
+    { "mcp7940_status",                 benchmark_status,               0 },
+    { "mcp7940_weekday",                benchmark_weekday,              0 },
+    { "mcp7940_leapyear",               benchmark_leapyear,             0 },
+    { "mcp7940_time",                   benchmark_time,                 0 },
+    { "mcp7940_date",                   benchmark_date,                 0 },
+    { "mcp7940_datetime",               benchmark_datetime,             0 },
+    { "mcp7940_datetime_atomic",        benchmark_datetime_atomic,      0 },
+    { "mcp7940_snapshot",               benchmark_snapshot,             0 },
+    { "mcp7940_snapshot_atomic",        benchmark_snapshot_atomic,      0 },
+    { "mcp7940_epoch",                  benchmark_epoch,                0 },
+    { "mcp7940_setweekday",             benchmark_setweekday,           0 },
+    { "mcp7940_settime",                benchmark_settime,              0 },
+    { "mcp7940_setdate",                benchmark_setdate,              0 },
+    { "mcp7940_setdatetime",            benchmark_setdatetime,          0 },
+    { "mcp7940_setepoch",               benchmark_setepoch,             0 },
+    { "mcp7940_trimming",               benchmark_trimming,             0 },
+    { "mcp7940_oscillator",             benchmark_oscillator,           0 },
+    { "mcp7940_oscillator_start",       benchmark_oscillator_start,     0 },
+#if MCP7940_MFP_MODE == MCP7940_MFP_MODE_OUTPUT
+    { "mcp7940_mfp_output",             benchmark_mfp_output,           0 },
+#endif
+#ifdef MCP7940_BATTERY_BACKUP_EN
+    { "mcp7940_powerfail_read",         benchmark_powerfail_read,       benchmark_powerfail },
+#endif
+    { "mcp7940_alarm_set",              benchmark_alarm_set,            0 },
+    { "mcp7940_alarm_get",              benchmark_alarm_get,            0 },
+    { "mcp7940_alarm_enable",           benchmark_alarm_enable,         0 },
+    { "mcp7940_alarm_clear",            benchmark_alarm_clear,          0 },
+    { "mcp7940_alarm_pending",          benchmark_alarm_pending,        0 },
+    { "mcp7940_sram_read",              benchmark_sram_read,            0 },
+    { "mcp7940_sram_write",             benchmark_sram_write,           0 },
+#ifdef MCP7940_HAS_EEPROM
+    { "mcp7940_eeprom_read",            benchmark_eeprom_read,          0 },
+    { "mcp7940_eeprom_write",           benchmark_eeprom_write,         0 },
+#endif
+#ifdef MCP7940_HAS_EUI
+    { "mcp7940_eui_read",               benchmark_eui_read,             0 },
+#endif
+#ifdef MCP7940_RECORD_EN
+    { "mcp7940_record_commit",          benchmark_record_commit,        0 },
+    { "mcp7940_record_restore",         benchmark_record_restore,       benchmark_record },
+#endif
+#ifdef MCP7940_CALIBRATION_EN
+    { "mcp7940_calibration_begin",      benchmark_calibration_begin,    0 },
+    { "mcp7940_calibration_end",        benchmark_calibration_end,      benchmark_window },
+    { "mcp7940_calibration_restore",    benchmark_calibration_restore,  benchmark_calibration },
+#endif
+#ifdef MCP7940_QUEUE_EN
+    { "mcp7940_queue_flush",            benchmark_queue_flush,          benchmark_queue },
+#endif
+#ifdef MCP7940_TICK_EN
+    { "mcp7940_tick_sync",              benchmark_tick_sync,            0 },
+    #ifdef MCP7940_TICK_MS
+    { "mcp7940_tick_timestamp",         benchmark_tick_timestamp,       0 },
+    #endif
+#endif
+#ifdef MCP7940_ASYNC_EN
+    { "mcp7940_datetime_async",         benchmark_datetime_async,       0 },
+    { "mcp7940_settime_async",          benchmark_settime_async,        0 },
+    { "mcp7940_setdate_async",          benchmark_setdate_async,        0 },
+    { "mcp7940_sram_read_async",        benchmark_sram_read_async,      0 },
+    { "mcp7940_sram_write_async",       benchmark_sram_write_async,     0 },
+#endif
+};
+
+static double benchmark_mean(unsigned long total, unsigned long calls)
+{
+    return ((double)total / (double)calls);
+}
+
+static void benchmark_add(TWI_Host_Statistics *total, const TWI_Host_Statistics *before)
+{
+    total->transactions += (twi_host_statistics.transactions - before->transactions);
+    total->starts       += (twi_host_statistics.starts - before->starts);
+    total->stops        += (twi_host_statistics.stops - before->stops);
+    total->bytes        += (twi_host_statistics.bytes - before->bytes);
+    total->nacks        += (twi_host_statistics.nacks - before->nacks);
+    total->cycles       += (twi_host_statistics.cycles - before->cycles);
+    total->wait_ms      += (twi_host_statistics.wait_ms - before->wait_ms);
+    total->time_us      += (twi_host_statistics.time_us - before->time_us);
+}
+
+/**
+ * @brief Runs all benchmark cases and prints one CSV row per function.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Optional number of calls per function as first argument (default @c BENCHMARK_CALLS).
+ *
+ * @return 0 if all calls succeeded, 1 if at least one call reported an error.
+ *
+ * @details
+ * Every case starts on a freshly initialized simulated device with a running oscillator (and a synchronised tick clock with @c MCP7940_TICK_EN), so the results do not depend on the order of the cases. If a case needs a preceding step (e.g. queued requests before mcp7940_queue_flush() or an open window before mcp7940_calibration_end()), the step is executed before every call and excluded from the numbers. The columns `transactions` to `cycles` are mean values per call, `errors` counts the calls that did not return `MCP7940_Error_None`.
+ */
+int main(int argc, char *argv[])
+{
+    unsigned long calls = (argc > 1) ? strtoul(argv[1], NULL, 10) : BENCHMARK_CALLS;
+    int result = 0;
+
+    if(!calls)
+    {
+        calls = BENCHMARK_CALLS;
+    }
+
+    printf("function,calls,errors,transactions,starts,stops,bytes,nacks,wait_ms,time_us,cycles\n");
+
+    for(unsigned char i = 0; i < (sizeof(benchmark_cases) / sizeof(benchmark_cases[0])); i++)
+    {
+        TWI_Host_Statistics total = { 0 };
+        unsigned long errors = 0;
+
+        twi_host_reset();
+        mcp7940_init();
+        mcp7940_setdatetime(&benchmark_reference);
+
+        #ifdef MCP7940_TICK_EN
+            mcp7940_tick_sync();
+        #endif
+        twi_host_clear();
+
+        for(unsigned long call = 0; call < calls; call++)
+        {
+            if(benchmark_cases[i].prepare)
+            {
+                benchmark_cases[i].prepare();
+            }
+
+            TWI_Host_Statistics before = twi_host_statistics;
+
+            if(benchmark_cases[i].run() != MCP7940_Error_None)
+            {
+                errors++;
+            }
+            benchmark_add(&total, &before);
+        }
+
+        if(errors)
+        {
+            result = 1;
+        }
+
+        printf("%s,%lu,%lu,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n",
+            benchmark_cases[i].name,
+            calls,
+            errors,
+            benchmark_mean(total.transactions, calls),
+            benchmark_mean(total.starts, calls),
+            benchmark_mean(total.stops, calls),
+            benchmark_mean(total.bytes, calls),
+            benchmark_mean(total.nacks, calls),
+            benchmark_mean(total.wait_ms, calls),
+            benchmark_mean(total.time_us, calls),
+            benchmark_mean(total.cycles, calls));
+    }
+    return result;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file eeprom.c
+ * @brief Regression test of the MCP7941x EEPROM and EUI access on the host platform.
+ *
+ * This file runs the EEPROM functions against the simulated EEPROM of the host TWI/I2C hardware abstraction layer, which does not acknowledge its address during a write cycle. Every write has to be split at the page boundaries, every access has to wait for the previous write cycle by acknowledge polling instead of a fixed delay, and the EUI has to be taken from the end of the protected unique ID area.
+ *
+ * Copied to the root of the library package, the test is built and run with:
+ * @code
+ * gcc -std=c99 -DMCP7940_HAL_PLATFORM=host -DMCP7940_VARIANT=MCP7940_VARIANT_79412 -I. -o eeprom eeprom.c drivers/rtc/mcp7940/mcp7940.c hal/host/twi/twi.c utils/time/validate.c
+ * ./eeprom
+ * @endcode
+ *
+ * @author g.raf
+ * @date 2026-10-14
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/drivers-rtc-mcp7940 "MCP7940 RTC driver library"
+ */
+
+#include <stdio.h>
+
+#include "hal/host/twi/twi.h"
+#include "drivers/rtc/mcp7940/mcp7940.h"
+
+#ifndef MCP7940_HAS_EEPROM
+    #error "The EEPROM test requires a variant with EEPROM (check MCP7940_VARIANT)"
+#endif
+
+/**
+ * @struct EEPROM_Case_t
+ * @brief Block written to and read back from the EEPROM.
+ */
+struct EEPROM_Case_t
+{
+    const char *name;       /**< Description printed in the result */
+    unsigned char address;  /**< First EEPROM address */
+    unsigned char length;   /**< Number of bytes */
+    unsigned long cycles;   /**< Expected write cycles (pages touched) */
+};
+/**
+ * @typedef EEPROM_Case
+ * @brief Alias for struct EEPROM_Case_t.
+ */
+typedef struct EEPROM_Case_t EEPROM_Case;
+
+static const EEPROM_Case eeprom_cases[] = {
+    { "single byte",      0x00,   1,  1UL },
+    { "one page",         0x08,   8,  1UL },
+    { "page crossing",    0x05,  20,  4UL },
+    { "last byte",        0x7F,   1,  1UL },
+    { "whole array",      0x00, 128, 16UL }
+};
+
+/**
+ * @brief Delay hook of the driver, implemented with the simulated clock.
+ *
+ * @param ms Delay in milliseconds.
+ */
+void systick_timer_wait_ms(unsigned int ms)
+{
+    twi_host_wait_ms(ms);
+}
+
+static unsigned char eeprom_run(const EEPROM_Case *test)
+{
+    unsigned char data[MCP7940_EEPROM_SIZE];
+    unsigned char back[MCP7940_EEPROM_SIZE];
+
+    for(unsigned char i = 0; i < test->length; i++)
+    {
+        data[i] = (unsigned char)((test->address + i) ^ 0x5A);
+    }
+
+    twi_host_reset();
+    mcp7940_init();
+    twi_host_clear();
+
+    MCP7940_Error write = mcp7940_eeprom_write(test->address, data, test->length);
+    unsigned long cycles = twi_host_statistics.cycles;
+
+    // The read has to wait for the write cycle of the last page by acknowledge polling
+    MCP7940_Error read = mcp7940_eeprom_read(test->address, back, test->length);
+
+    unsigned char match = 1;
+
+    for(unsigned char i = 0; i < test->length; i++)
+    {
+        if((back[i] != data[i]) || (twi_host_eeprom_peek(test->address + i) != data[i]))
+        {
+            match = 0;
+        }
+    }
+
+    unsigned char passed = ((write == MCP7940_Error_None) && (read == MCP7940_Error_None) && match && (cycles == test->cycles) && !twi_host_statistics.wait_ms);
+
+    printf("%-20s write=%d read=%d cycles=%lu expected=%lu polls=%lu wait_ms=%lu %s\n",
+        test->name,
+        write,
+        read,
+        cycles,
+        test->cycles,
+        twi_host_statistics.nacks,
+        twi_host_statistics.wait_ms,
+        passed ? "PASS" : "FAIL");
+
+    return passed;
+}
+
+static unsigned char eeprom_range(void)
+{
+    unsigned char data[2] = { 0 };
+
+    twi_host_reset();
+    mcp7940_init();
+    twi_host_clear();
+
+    // Blocks beyond the array are rejected without a bus access
+    unsigned char passed = ((mcp7940_eeprom_write(0x7F, data, 2) == MCP7940_Error_Fail) &&
+                            (mcp7940_eeprom_read(MCP7940_EEPROM_SIZE, data, 1) == MCP7940_Error_Fail) &&
+                            (mcp7940_eeprom_write(0x00, data, 0) == MCP7940_Error_Fail) &&
+                            !twi_host_statistics.transactions);
+
+    printf("%-20s transactions=%lu %s\n", "range", twi_host_statistics.transactions, passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+#ifdef MCP7940_HAS_EUI
+    static unsigned char eeprom_eui(void)
+    {
+        unsigned char eui[MCP7940_HAS_EUI];
+
+        twi_host_reset();
+        mcp7940_init();
+
+        for(unsigned char i = 0; i < MCP7940_EUI_AREA; i++)
+        {
+            twi_host_eeprom_poke((MCP7940_EUI + i), (0xA0 + i));
+        }
+
+        MCP7940_Error error = mcp7940_eui_read(eui);
+        unsigned char passed = (error == MCP7940_Error_None);
+
+        // The EUI is stored at the end of the unique ID area, most significant byte first
+        for(unsigned char i = 0; i < MCP7940_HAS_EUI; i++)
+        {
+            if(eui[i] != (0xA0 + (MCP7940_EUI_AREA - MCP7940_HAS_EUI) + i))
+            {
+                passed = 0;
+            }
+        }
+
+        printf("%-20s error=%d size=%u %s\n", "eui", error, MCP7940_HAS_EUI, passed ? "PASS" : "FAIL");
+        return passed;
+    }
+#endif
+
+/**
+ * @brief Runs all EEPROM cases and prints one result line per case.
+ *
+ * @return 0 if every block was written in the expected number of write cycles without a fixed delay and read back unchanged, out-of-range blocks were rejected and (for variants with EUI) the EUI was read, otherwise 1.
+ *
+ * @details
+ * The simulated EEPROM does not acknowledge its address for @c TWI_HOST_EEPROM_CYCLE_US after a page write, so the printed number of polls shows how long the driver waited for the write cycles.
+ */
+int main(void)
+{
+    int result = 0;
+
+    for(unsigned char i = 0; i < (sizeof(eeprom_cases) / sizeof(eeprom_cases[0])); i++)
+    {
+        if(!eeprom_run(&eeprom_cases[i]))
+        {
+            result = 1;
+        }
+    }
+
+    if(!eeprom_range())
+    {
+        result = 1;
+    }
+
+    #ifdef MCP7940_HAS_EUI
+        if(!eeprom_eui())
+        {
+            result = 1;
+        }
+    #endif
+
+    return result;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file scheduler.c
+ * @brief Regression test of the MCP7940 alarm scheduler on the host platform.
+ *
+ * This file runs the alarm scheduler against the simulated MCP7940 of the host TWI/I2C hardware abstraction layer and counts the MFP wakeups (ALM0 interrupts) per deadline. Every deadline has to be reported exactly once, at its own second, and with a single wakeup, so the firmware can sleep between the deadlines instead of polling.
+ *
+ * Copied to the root of the library package, the test is built and run with:
+ * @code
+ * gcc -std=c99 -DMCP7940_HAL_PLATFORM=host -DMCP7940_MFP_MODE=MCP7940_MFP_MODE_ALARM -I. -o scheduler scheduler.c drivers/rtc/mcp7940/mcp7940.c drivers/rtc/mcp7940/mcp7940_scheduler.c hal/host/twi/twi.c utils/time/validate.c
+ * ./scheduler
+ * @endcode
+ *
+ * @author g.raf
+ * @date 2026-10-14
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/drivers-rtc-mcp7940 "MCP7940 RTC driver library"
+ */
+
+#include <stdio.h>
+
+#include "hal/host/twi/twi.h"
+#include "drivers/rtc/mcp7940/mcp7940_scheduler.h"
+
+/**
+ * @struct SCHEDULER_Case_t
+ * @brief Deadline under test, relative to the reference date 14.10.2026 12:30:00.
+ */
+struct SCHEDULER_Case_t
+{
+    const char *name;           /**< Description printed in the result */
+    FORMAT_DateTime deadline;   /**< Deadline passed to mcp7940_scheduler_add() */
+    unsigned long seconds;      /**< Expected seconds from the reference to the callback */
+};
+/**
+ * @typedef SCHEDULER_Case
+ * @brief Alias for struct SCHEDULER_Case_t.
+ */
+typedef struct SCHEDULER_Case_t SCHEDULER_Case;
+
+// 14.10.2026 12:30:00 (Unix time 1791981000)
+#define SCHEDULER_REFERENCE 1791981000UL
+
+static const SCHEDULER_Case scheduler_cases[] = {
+    { "same day",           { { 14, 10, 26 }, { 18,  0,  0 } }, 19800UL },
+    { "next second",        { { 14, 10, 26 }, { 12, 30,  1 } }, 1UL },
+    { "next day",           { { 15, 10, 26 }, {  6,  0,  0 } }, 63000UL },
+    { "same date in month", { { 14, 11, 26 }, { 12, 30,  0 } }, 2678400UL },
+    { "new year",           { {  1,  1, 27 }, {  0,  0,  0 } }, 6780600UL }
+};
+
+// 14.10.2026 23:59:58 and a deadline 32 seconds later, just after midnight
+#define SCHEDULER_MIDNIGHT 1792022398UL
+#define SCHEDULER_MIDNIGHT_WINDOW 20000UL
+#define SCHEDULER_MIDNIGHT_STEP 50UL
+
+static const FORMAT_DateTime scheduler_midnight = { { 15, 10, 26 }, { 0, 0, 30 } };
+
+static unsigned char scheduler_calls;
+
+/**
+ * @brief Delay hook of the driver, implemented with the simulated clock.
+ *
+ * @param ms Delay in milliseconds.
+ */
+void systick_timer_wait_ms(unsigned int ms)
+{
+    twi_host_wait_ms(ms);
+}
+
+static void scheduler_callback(unsigned char id)
+{
+    (void)id;
+    scheduler_calls++;
+}
+
+static unsigned long scheduler_epoch(void)
+{
+    unsigned long epoch = 0;
+
+    mcp7940_epoch(&epoch);
+    return epoch;
+}
+
+static unsigned long scheduler_run(unsigned long seconds, unsigned long *wakeups, unsigned long reference)
+{
+    unsigned long elapsed = 0;
+
+    while(!scheduler_calls && (elapsed <= seconds))
+    {
+        twi_host_elapse(1000000UL);
+
+        if(twi_host_peek(MCP7940_ALM0WKDAY) & MCP7940_ALARM_ALMIF_bm)
+        {
+            (*wakeups)++;
+            mcp7940_scheduler_interrupt();
+        }
+
+        while(mcp7940_scheduler_pending())
+        {
+            mcp7940_scheduler_process();
+        }
+        elapsed = (scheduler_epoch() - reference);
+    }
+    return elapsed;
+}
+
+static unsigned char scheduler_uninitialized(void)
+{
+    unsigned long wakeups = 0;
+
+    // A weekday counter that was never set (0) is initialized before a full match is armed
+    twi_host_reset();
+    mcp7940_init();
+    mcp7940_setepoch(SCHEDULER_REFERENCE);
+    twi_host_poke(MCP7940_RTCWKDAY, (twi_host_peek(MCP7940_RTCWKDAY) & 0xF8));
+
+    scheduler_calls = 0;
+    mcp7940_scheduler_init();
+    mcp7940_scheduler_add(&scheduler_cases[0].deadline, scheduler_callback, 0);
+    mcp7940_scheduler_process();
+
+    unsigned long elapsed = scheduler_run(scheduler_cases[0].seconds, &wakeups, SCHEDULER_REFERENCE);
+    unsigned char passed = ((scheduler_calls == 1) && (wakeups <= 1) && (elapsed == scheduler_cases[0].seconds));
+
+    printf("%-20s calls=%u wakeups=%lu elapsed=%lu expected=%lu %s\n", "no weekday", scheduler_calls, wakeups, elapsed, scheduler_cases[0].seconds, passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+static unsigned int scheduler_midnight_sweep(void)
+{
+    unsigned int failures = 0;
+
+    // The deadline is added at every 50 us of the last 20 ms before midnight, so the reads of the scheduler straddle the date rollover in some runs
+    for(unsigned long start = 0; start < SCHEDULER_MIDNIGHT_WINDOW; start += SCHEDULER_MIDNIGHT_STEP)
+    {
+        unsigned long wakeups = 0;
+
+        twi_host_reset();
+        mcp7940_init();
+        mcp7940_setepoch(SCHEDULER_MIDNIGHT);
+
+        // Align to the start of 23:59:59 on the simulated time base without a bus access
+        unsigned char second = twi_host_peek(MCP7940_RTCSEC);
+
+        while(twi_host_peek(MCP7940_RTCSEC) == second)
+        {
+            twi_host_elapse(SCHEDULER_MIDNIGHT_STEP);
+        }
+        twi_host_elapse(1000000UL - SCHEDULER_MIDNIGHT_WINDOW + start);
+
+        scheduler_calls = 0;
+        mcp7940_scheduler_init();
+        mcp7940_scheduler_add(&scheduler_midnight, scheduler_callback, 0);
+        mcp7940_scheduler_process();
+
+        unsigned long elapsed = scheduler_run(60UL, &wakeups, SCHEDULER_MIDNIGHT);
+
+        if((scheduler_calls != 1) || (wakeups > 1) || (elapsed != 32UL))
+        {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+/**
+ * @brief Runs all scheduler cases and prints one result line per deadline.
+ *
+ * @return 0 if a missing deadline is rejected and every deadline (also one added just before midnight) was reported exactly once, at its second and with a single wakeup, otherwise 1.
+ *
+ * @details
+ * The simulated time advances in steps of one second. The midnight case adds a deadline at 400 points in time within the last 20 ms before a date rollover, so the reads of mcp7940_scheduler_process() straddle the rollover in some runs. A wakeup is counted whenever the ALMIF flag of ALM0 is set after a step, which is the condition that asserts the MFP pin, and is passed to mcp7940_scheduler_interrupt() and mcp7940_scheduler_process() like the interrupt service routine and main loop of a firmware would.
+ */
+int main(void)
+{
+    int result = 0;
+
+    if(mcp7940_scheduler_add(0, scheduler_callback, 0) != MCP7940_Error_Fail)
+    {
+        printf("missing deadline accepted FAIL\n");
+        result = 1;
+    }
+
+    for(unsigned char i = 0; i < (sizeof(scheduler_cases) / sizeof(scheduler_cases[0])); i++)
+    {
+        unsigned long wakeups = 0;
+
+        twi_host_reset();
+        mcp7940_init();
+        mcp7940_setepoch(SCHEDULER_REFERENCE);
+
+        scheduler_calls = 0;
+        mcp7940_scheduler_init();
+        mcp7940_scheduler_add(&scheduler_cases[i].deadline, scheduler_callback, 0);
+        mcp7940_scheduler_process();
+
+        unsigned long elapsed = scheduler_run(scheduler_cases[i].seconds, &wakeups, SCHEDULER_REFERENCE);
+
+        unsigned char passed = ((scheduler_calls == 1) && (wakeups <= 1) && (elapsed == scheduler_cases[i].seconds));
+
+        if(!passed)
+        {
+            result = 1;
+        }
+
+        printf("%-20s calls=%u wakeups=%lu elapsed=%lu expected=%lu %s\n",
+            scheduler_cases[i].name,
+            scheduler_calls,
+            wakeups,
+            elapsed,
+            scheduler_cases[i].seconds,
+            passed ? "PASS" : "FAIL");
+    }
+
+    if(!scheduler_uninitialized())
+    {
+        result = 1;
+    }
+
+    unsigned int failures = scheduler_midnight_sweep();
+
+    if(failures)
+    {
+        result = 1;
+    }
+
+    printf("%-20s runs=%lu failures=%u %s\n",
+        "midnight",
+        (SCHEDULER_MIDNIGHT_WINDOW / SCHEDULER_MIDNIGHT_STEP),
+        failures,
+        failures ? "FAIL" : "PASS");
+
+    return result;
+}
@@ -0,0 +1,685 @@
+/**
+ * @file twi.c
+ * @brief Implementation of the host TWI/I2C hardware abstraction layer with a simulated MCP7940.
+ *
+ * This file contains a register-file model of the MCP7940 (RTCC registers and SRAM) behind the TWI/I2C primitives used by the driver. The model advances its clock with the simulated bus and wait time, wraps the address pointer inside the RTCC and SRAM block like the device, evaluates both alarms and records power-fail timestamps. A second slave models the EEPROM of the MCP7941x with page writes and a write cycle during which its address is not acknowledged. All bus events are counted in ::twi_host_statistics.
+ *
+ * @author g.raf
+ * @date 2026-10-14
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/drivers-rtc-mcp7940 "MCP7940 RTC driver library"
+ */
+
+#include "twi.h"
+
+#define TWI_HOST_RTCSEC   0x00
+#define TWI_HOST_RTCMIN   0x01
+#define TWI_HOST_RTCHOUR  0x02
+#define TWI_HOST_RTCWKDAY 0x03
+#define TWI_HOST_RTCDATE  0x04
+#define TWI_HOST_RTCMTH   0x05
+#define TWI_HOST_RTCYEAR  0x06
+#define TWI_HOST_CONTROL  0x07
+#define TWI_HOST_ALM0     0x0A
+#define TWI_HOST_ALM1     0x11
+#define TWI_HOST_PWRDN    0x18
+#define TWI_HOST_PWRUP    0x1C
+#define TWI_HOST_SRAM     0x20
+
+#define TWI_HOST_ST_bm      0x80
+#define TWI_HOST_FORMAT_bm  0x40
+#define TWI_HOST_PM_bm      0x20
+#define TWI_HOST_OSCRUN_bm  0x20
+#define TWI_HOST_PWRFAIL_bm 0x10
+#define TWI_HOST_VBATEN_bm  0x08
+#define TWI_HOST_LPYR_bm    0x20
+#define TWI_HOST_EXTOSC_bm  0x08
+#define TWI_HOST_ALM0EN_bm  0x10
+#define TWI_HOST_ALM1EN_bm  0x20
+#define TWI_HOST_ALMIF_bm   0x08
+
+#define TWI_HOST_EEPROM_ARRAY 0x80
+#define TWI_HOST_EEPROM_PAGE  8
+
+enum TWI_Host_State_t
+{
+    TWI_Host_Idle = 0,
+    TWI_Host_Started,
+    TWI_Host_Pointer,
+    TWI_Host_Write,
+    TWI_Host_Read,
+    TWI_Host_Ignore
+};
+typedef enum TWI_Host_State_t TWI_Host_State;
+
+/**
+ * @brief Bus events counted since the last twi_host_reset() or twi_host_clear().
+ */
+TWI_Host_Statistics twi_host_statistics;
+
+static unsigned char twi_host_registers[TWI_HOST_REGISTERS];
+static unsigned char twi_host_pointer;
+static TWI_Host_State twi_host_state;
+static unsigned char twi_host_nacks;
+static unsigned long twi_host_fraction;
+
+static unsigned char twi_host_eeprom[TWI_HOST_EEPROM_SIZE];
+static unsigned char twi_host_eeprom_pointer;
+static unsigned char twi_host_eeprom_selected;
+static unsigned char twi_host_eeprom_written;
+static unsigned long twi_host_eeprom_cycle;
+
+static unsigned char twi_host_tobinary(unsigned char value)
+{
+    return (((value >> 4) * 10) + (value & 0x0F));
+}
+
+static unsigned char twi_host_tobcd(unsigned char value)
+{
+    return (((value / 10) << 4) | (value % 10));
+}
+
+static unsigned char twi_host_running(void)
+{
+    return ((twi_host_registers[TWI_HOST_RTCSEC] & TWI_HOST_ST_bm) || (twi_host_registers[TWI_HOST_CONTROL] & TWI_HOST_EXTOSC_bm));
+}
+
+static void twi_host_status(void)
+{
+    unsigned char year = twi_host_tobinary(twi_host_registers[TWI_HOST_RTCYEAR]);
+
+    twi_host_registers[TWI_HOST_RTCWKDAY] &= ~TWI_HOST_OSCRUN_bm;
+    twi_host_registers[TWI_HOST_RTCMTH]   &= ~TWI_HOST_LPYR_bm;
+
+    if(twi_host_running())
+    {
+        twi_host_registers[TWI_HOST_RTCWKDAY] |= TWI_HOST_OSCRUN_bm;
+    }
+
+    // The device covers 2000 to 2099, so every fourth year is a leap year
+    if(!(year & 0x03))
+    {
+        twi_host_registers[TWI_HOST_RTCMTH] |= TWI_HOST_LPYR_bm;
+    }
+}
+
+static unsigned char twi_host_month_days(unsigned char month, unsigned char year)
+{
+    static const unsigned char days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    if((month < 1) || (month > 12))
+    {
+        return 31;
+    }
+    return (days[month - 1] + (((month == 2) && !(year & 0x03)) ? 1 : 0));
+}
+
+static unsigned char twi_host_hour(void)
+{
+    unsigned char hour = twi_host_registers[TWI_HOST_RTCHOUR];
+
+    if(!(hour & TWI_HOST_FORMAT_bm))
+    {
+        return twi_host_tobinary(hour & 0x3F);
+    }
+
+    // 12-hour format: 12 AM is 0, 12 PM is 12
+    unsigned char value = (twi_host_tobinary(hour & 0x1F) % 12);
+    return (hour & TWI_HOST_PM_bm) ? (value + 12) : value;
+}
+
+static void twi_host_sethour(unsigned char hour)
+{
+    if(!(twi_host_registers[TWI_HOST_RTCHOUR] & TWI_HOST_FORMAT_bm))
+    {
+        twi_host_registers[TWI_HOST_RTCHOUR] = twi_host_tobcd(hour);
+        return;
+    }
+    twi_host_registers[TWI_HOST_RTCHOUR] = (TWI_HOST_FORMAT_bm | ((hour >= 12) ? TWI_HOST_PM_bm : 0) | twi_host_tobcd(((hour % 12) == 0) ? 12 : (hour % 12)));
+}
+
+static unsigned char twi_host_match(unsigned char base)
+{
+    const unsigned char *alarm = &twi_host_registers[base];
+    const unsigned char *now   = twi_host_registers;
+
+    unsigned char second = ((alarm[0] & 0x7F) == (now[TWI_HOST_RTCSEC] & 0x7F));
+    unsigned char minute = ((alarm[1] & 0x7F) == now[TWI_HOST_RTCMIN]);
+    unsigned char hour   = ((alarm[2] & 0x7F) == (now[TWI_HOST_RTCHOUR] & 0x7F));
+    unsigned char wkday  = ((alarm[3] & 0x07) == (now[TWI_HOST_RTCWKDAY] & 0x07));
+    unsigned char date   = ((alarm[4] & 0x3F) == now[TWI_HOST_RTCDATE]);
+    unsigned char month  = ((alarm[5] & 0x1F) == (now[TWI_HOST_RTCMTH] & 0x1F));
+
+    switch ((alarm[3] >> 4) & 0x07)
+    {
+        case 0:
+            return second;
+        case 1:
+            return minute;
+        case 2:
+            return hour;
+        case 3:
+            return wkday;
+        case 4:
+            return date;
+        case 7:
+            return (second && minute && hour && wkday && date && month);
+        default:
+            return 0;
+    }
+}
+
+static void twi_host_alarms(void)
+{
+    if((twi_host_registers[TWI_HOST_CONTROL] & TWI_HOST_ALM0EN_bm) && twi_host_match(TWI_HOST_ALM0))
+    {
+        twi_host_registers[TWI_HOST_ALM0 + 3] |= TWI_HOST_ALMIF_bm;
+    }
+
+    if((twi_host_registers[TWI_HOST_CONTROL] & TWI_HOST_ALM1EN_bm) && twi_host_match(TWI_HOST_ALM1))
+    {
+        twi_host_registers[TWI_HOST_ALM1 + 3] |= TWI_HOST_ALMIF_bm;
+    }
+}
+
+static void twi_host_tick(void)
+{
+    unsigned char second = twi_host_tobinary(twi_host_registers[TWI_HOST_RTCSEC] & 0x7F) + 1;
+
+    if(second < 60)
+    {
+        twi_host_registers[TWI_HOST_RTCSEC] = ((twi_host_registers[TWI_HOST_RTCSEC] & TWI_HOST_ST_bm) | twi_host_tobcd(second));
+        twi_host_alarms();
+        return;
+    }
+    twi_host_registers[TWI_HOST_RTCSEC] &= TWI_HOST_ST_bm;
+
+    unsigned char minute = twi_host_tobinary(twi_host_registers[TWI_HOST_RTCMIN]) + 1;
+
+    if(minute < 60)
+    {
+        twi_host_registers[TWI_HOST_RTCMIN] = twi_host_tobcd(minute);
+        twi_host_alarms();
+        return;
+    }
+    twi_host_registers[TWI_HOST_RTCMIN] = 0;
+
+    unsigned char hour = (twi_host_hour() + 1);
+
+    if(hour < 24)
+    {
+        twi_host_sethour(hour);
+        twi_host_alarms();
+        return;
+    }
+    twi_host_sethour(0);
+
+    unsigned char wkday = (twi_host_registers[TWI_HOST_RTCWKDAY] & 0x07);
+    twi_host_registers[TWI_HOST_RTCWKDAY] = ((twi_host_registers[TWI_HOST_RTCWKDAY] & 0xF8) | ((wkday >= 7) ? 1 : (wkday + 1)));
+
+    unsigned char year  = twi_host_tobinary(twi_host_registers[TWI_HOST_RTCYEAR]);
+    unsigned char month = twi_host_tobinary(twi_host_registers[TWI_HOST_RTCMTH] & 0x1F);
+    unsigned char day   = twi_host_tobinary(twi_host_registers[TWI_HOST_RTCDATE]) + 1;
+
+    if(day > twi_host_month_days(month, year))
+    {
+        day = 1;
+
+        if(++month > 12)
+        {
+            month = 1;
+            year  = ((year + 1) % 100);
+        }
+    }
+    twi_host_registers[TWI_HOST_RTCDATE] = twi_host_tobcd(day);
+    twi_host_registers[TWI_HOST_RTCMTH]  = twi_host_tobcd(month);
+    twi_host_registers[TWI_HOST_RTCYEAR] = twi_host_tobcd(year);
+
+    twi_host_status();
+    twi_host_alarms();
+}
+
+static void twi_host_stamp(unsigned char address)
+{
+    twi_host_registers[address]     = twi_host_registers[TWI_HOST_RTCMIN];
+    twi_host_registers[address + 1] = twi_host_registers[TWI_HOST_RTCHOUR];
+    twi_host_registers[address + 2] = twi_host_registers[TWI_HOST_RTCDATE];
+    twi_host_registers[address + 3] = (((twi_host_registers[TWI_HOST_RTCWKDAY] & 0x07) << 5) | (twi_host_registers[TWI_HOST_RTCMTH] & 0x1F));
+}
+
+static void twi_host_store(unsigned char address, unsigned char data)
+{
+    switch (address)
+    {
+        case TWI_HOST_RTCWKDAY:
+            // OSCRUN is read-only, PWRFAIL can only be cleared, which also clears the timestamps
+            if(!(data & TWI_HOST_PWRFAIL_bm))
+            {
+                for(unsigned char i = TWI_HOST_PWRDN; i < TWI_HOST_SRAM; i++)
+                {
+                    twi_host_registers[i] = 0;
+                }
+            }
+            data = ((data & ~(TWI_HOST_OSCRUN_bm | TWI_HOST_PWRFAIL_bm)) | (twi_host_registers[TWI_HOST_RTCWKDAY] & data & TWI_HOST_PWRFAIL_bm));
+        break;
+        case TWI_HOST_RTCMTH:
+            data &= ~TWI_HOST_LPYR_bm;
+        break;
+        default:
+        break;
+    }
+    twi_host_registers[address] = data;
+
+    if(address <= TWI_HOST_CONTROL)
+    {
+        twi_host_status();
+    }
+}
+
+static void twi_host_eeprom_store(unsigned char data)
+{
+    // Only the array can be written, the unique ID area requires an unlock sequence that the driver does not use
+    if(twi_host_eeprom_pointer < TWI_HOST_EEPROM_ARRAY)
+    {
+        twi_host_eeprom[twi_host_eeprom_pointer] = data;
+        twi_host_eeprom_written = 1;
+    }
+
+    // The address counter of a page write wraps inside the page
+    twi_host_eeprom_pointer = ((twi_host_eeprom_pointer & ~(TWI_HOST_EEPROM_PAGE - 1)) | ((twi_host_eeprom_pointer + 1) & (TWI_HOST_EEPROM_PAGE - 1)));
+}
+
+static unsigned char twi_host_next(unsigned char address)
+{
+    // The address pointer wraps inside the RTCC and the SRAM block
+    if(address == (TWI_HOST_SRAM - 1))
+    {
+        return 0;
+    }
+    if(address == (TWI_HOST_REGISTERS - 1))
+    {
+        return TWI_HOST_SRAM;
+    }
+    return (address + 1);
+}
+
+static void twi_host_bits(unsigned char bits)
+{
+    twi_host_elapse(((bits * 1000000UL) + (TWI_HOST_FREQUENCY / 2)) / TWI_HOST_FREQUENCY);
+}
+
+static void twi_host_startup(void)
+{
+    for(unsigned char i = 0; i < TWI_HOST_REGISTERS; i++)
+    {
+        twi_host_registers[i] = 0;
+    }
+    twi_host_pointer  = 0;
+    twi_host_state    = TWI_Host_Idle;
+    twi_host_nacks    = 0;
+    twi_host_fraction = 0;
+
+    // An interrupted write cycle is lost, the EEPROM array itself is non-volatile
+    twi_host_eeprom_pointer  = 0;
+    twi_host_eeprom_selected = 0;
+    twi_host_eeprom_written  = 0;
+    twi_host_eeprom_cycle    = 0;
+
+    twi_host_status();
+}
+
+/**
+ * @brief Initializes the host TWI/I2C layer.
+ *
+ * @details
+ * Releases the simulated bus. The register file of the simulated MCP7940 and the statistics are kept, use twi_host_reset() for a power-on state.
+ */
+void twi_init(void)
+{
+    twi_host_state = TWI_Host_Idle;
+}
+
+/**
+ * @brief Generates a (repeated) start condition on the simulated bus.
+ *
+ * @return `TWI_None`, a start condition is always possible on the host.
+ */
+TWI_Status twi_start(void)
+{
+    if(twi_host_state == TWI_Host_Idle)
+    {
+        twi_host_statistics.transactions++;
+    }
+    twi_host_statistics.starts++;
+    twi_host_state = TWI_Host_Started;
+
+    twi_host_bits(1);
+    return TWI_None;
+}
+
+/**
+ * @brief Sends a slave address with the transfer direction.
+ *
+ * @param address 7-bit slave address.
+ * @param operation `TWI_WRITE` or `TWI_READ`.
+ *
+ * @return Returns one of the following error codes:
+ * - `TWI_None` if the simulated MCP7940 or EEPROM acknowledged the address.
+ * - `TWI_Nack` if @p address matches neither @c TWI_HOST_ADDRESS nor @c TWI_HOST_EEPROM_ADDRESS, the EEPROM is in a write cycle or a NACK was injected with twi_host_nack().
+ * - `TWI_Error` if no start condition was generated before.
+ *
+ * @details
+ * If the bus is already owned by a previous address, a repeated start condition is generated first. A write selects the register pointer (or EEPROM address) with the next data byte, a read continues at the current register pointer (or EEPROM address).
+ */
+TWI_Status twi_address(unsigned char address, TWI_Operation operation)
+{
+    if(twi_host_state == TWI_Host_Idle)
+    {
+        twi_host_statistics.bytes++;
+        twi_host_bits(9);
+        return TWI_Error;
+    }
+
+    // Like the AVR0/1 master, an address on an owned bus generates a repeated start
+    if(twi_host_state != TWI_Host_Started)
+    {
+        twi_host_statistics.starts++;
+        twi_host_bits(1);
+    }
+    twi_host_statistics.bytes++;
+    twi_host_bits(9);
+
+    unsigned char eeprom = ((address == TWI_HOST_EEPROM_ADDRESS) && !twi_host_eeprom_cycle);
+
+    if(((address != TWI_HOST_ADDRESS) && !eeprom) || twi_host_nacks)
+    {
+        if(twi_host_nacks)
+        {
+            twi_host_nacks--;
+        }
+        twi_host_statistics.nacks++;
+        twi_host_state = TWI_Host_Ignore;
+        return TWI_Nack;
+    }
+    twi_host_eeprom_selected = eeprom;
+    twi_host_state = (operation == TWI_READ) ? TWI_Host_Read : TWI_Host_Pointer;
+
+    return TWI_None;
+}
+
+/**
+ * @brief Transmits one data byte to the simulated MCP7940.
+ *
+ * @param data Register pointer or EEPROM address (first byte after a write address), register value or EEPROM data.
+ *
+ * @return Returns one of the following error codes:
+ * - `TWI_None` if the byte was acknowledged.
+ * - `TWI_Nack` if the register pointer is outside the RTCC and SRAM block.
+ * - `TWI_Error` if the bus is not addressed for a write.
+ *
+ * @details
+ * Data bytes for the EEPROM are written into the page of the current address, further bytes wrap to the start of the page. Writes to the unique ID area are acknowledged but ignored.
+ */
+TWI_Status twi_set(unsigned char data)
+{
+    twi_host_statistics.bytes++;
+    twi_host_bits(9);
+
+    switch (twi_host_state)
+    {
+        case TWI_Host_Pointer:
+            if(twi_host_eeprom_selected)
+            {
+                twi_host_eeprom_pointer = data;
+                twi_host_state = TWI_Host_Write;
+                return TWI_None;
+            }
+
+            if(data >= TWI_HOST_REGISTERS)
+            {
+                twi_host_statistics.nacks++;
+                twi_host_state = TWI_Host_Ignore;
+                return TWI_Nack;
+            }
+            twi_host_pointer = data;
+            twi_host_state = TWI_Host_Write;
+        return TWI_None;
+        case TWI_Host_Write:
+            if(twi_host_eeprom_selected)
+            {
+                twi_host_eeprom_store(data);
+                return TWI_None;
+            }
+            twi_host_store(twi_host_pointer, data);
+            twi_host_pointer = twi_host_next(twi_host_pointer);
+        return TWI_None;
+        default:
+        return TWI_Error;
+    }
+}
+
+/**
+ * @brief Receives one data byte from the simulated MCP7940.
+ *
+ * @param data Pointer that receives the register value at the current register pointer (or the EEPROM byte at the current address).
+ * @param acknowledge `TWI_ACK` if further bytes follow, `TWI_NACK` for the last byte.
+ *
+ * @return `TWI_None` if a byte was received, `TWI_Error` if the bus is not addressed for a read.
+ */
+TWI_Status twi_get(unsigned char *data, TWI_Acknowledge acknowledge)
+{
+    (void)acknowledge;
+
+    twi_host_statistics.bytes++;
+    twi_host_bits(9);
+
+    if(twi_host_state != TWI_Host_Read)
+    {
+        return TWI_Error;
+    }
+
+    if(twi_host_eeprom_selected)
+    {
+        // Addresses between the array and the unique ID area are not implemented and read as erased
+        *data = twi_host_eeprom[twi_host_eeprom_pointer++];
+        return TWI_None;
+    }
+
+    *data = twi_host_registers[twi_host_pointer];
+    twi_host_pointer = twi_host_next(twi_host_pointer);
+
+    return TWI_None;
+}
+
+/**
+ * @brief Generates a stop condition and releases the simulated bus.
+ *
+ * @details
+ * If data bytes were written to the EEPROM, its write cycle of @c TWI_HOST_EEPROM_CYCLE_US starts.
+ */
+void twi_stop(void)
+{
+    twi_host_statistics.stops++;
+    twi_host_state = TWI_Host_Idle;
+
+    twi_host_bits(1);
+
+    if(twi_host_eeprom_written)
+    {
+        twi_host_statistics.cycles++;
+        twi_host_eeprom_written = 0;
+        twi_host_eeprom_cycle   = TWI_HOST_EEPROM_CYCLE_US;
+    }
+    twi_host_eeprom_selected = 0;
+}
+
+/**
+ * @brief Puts the simulated MCP7940 into its power-on state and clears the statistics.
+ *
+ * @details
+ * All registers and the SRAM are cleared as after a first power-up without battery, so the oscillator is stopped. The register pointer, injected NACKs and the sub-second time are reset as well. The EEPROM is erased (0xFF) as delivered, including the unique ID area, which a test can program with twi_host_eeprom_poke().
+ */
+void twi_host_reset(void)
+{
+    for(unsigned int i = 0; i < TWI_HOST_EEPROM_SIZE; i++)
+    {
+        twi_host_eeprom[i] = 0xFF;
+    }
+    twi_host_startup();
+    twi_host_clear();
+}
+
+/**
+ * @brief Clears the statistics without changing the simulated MCP7940.
+ */
+void twi_host_clear(void)
+{
+    twi_host_statistics = (TWI_Host_Statistics){ 0 };
+}
+
+/**
+ * @brief Reads a register of the simulated MCP7940 without a bus access.
+ *
+ * @param address Register address (0x00 to @c TWI_HOST_REGISTERS - 1).
+ *
+ * @return Register value, or 0 for an invalid @p address.
+ */
+unsigned char twi_host_peek(unsigned char address)
+{
+    return (address < TWI_HOST_REGISTERS) ? twi_host_registers[address] : 0;
+}
+
+/**
+ * @brief Writes a register of the simulated MCP7940 without a bus access.
+ *
+ * @param address Register address (0x00 to @c TWI_HOST_REGISTERS - 1).
+ * @param data Register value. Read-only bits (OSCRUN, LPYR) are not modified, but PWRFAIL can be set to prepare a test.
+ */
+void twi_host_poke(unsigned char address, unsigned char data)
+{
+    if(address >= TWI_HOST_REGISTERS)
+    {
+        return;
+    }
+    twi_host_registers[address] = data;
+    twi_host_status();
+}
+
+/**
+ * @brief Advances the simulated time.
+ *
+ * @param microseconds Time that passes, e.g. the duration of a bus transfer or of a delay.
+ *
+ * @details
+ * The simulated MCP7940 increments its time and calendar for every full second while the oscillator is running (ST or EXTOSC set), including the rollover of minutes, hours (in 12- and 24-hour format), days, months and years, the weekday and the leap-year flag. Both alarms are evaluated after every increment. A running write cycle of the EEPROM advances independently of the oscillator.
+ */
+void twi_host_elapse(unsigned long microseconds)
+{
+    twi_host_statistics.time_us += microseconds;
+
+    twi_host_eeprom_cycle = (twi_host_eeprom_cycle > microseconds) ? (twi_host_eeprom_cycle - microseconds) : 0;
+
+    if(!twi_host_running())
+    {
+        return;
+    }
+
+    twi_host_fraction += microseconds;
+
+    while(twi_host_fraction >= 1000000UL)
+    {
+        twi_host_fraction -= 1000000UL;
+        twi_host_tick();
+    }
+}
+
+/**
+ * @brief Blocks for the given time on the simulated clock.
+ *
+ * @param ms Delay in milliseconds.
+ *
+ * @details
+ * This function does not wait in real time but advances the simulated time and counts the delay in @c twi_host_statistics.wait_ms. A host application implements the systick_timer_wait_ms() hook of the driver with it.
+ */
+void twi_host_wait_ms(unsigned int ms)
+{
+    twi_host_statistics.wait_ms += ms;
+    twi_host_elapse(ms * 1000UL);
+}
+
+/**
+ * @brief Injects missing acknowledges for the next slave addresses.
+ *
+ * @param count Number of subsequent address bytes that are answered with a NACK.
+ */
+void twi_host_nack(unsigned char count)
+{
+    twi_host_nacks = count;
+}
+
+/**
+ * @brief Simulates an outage of the main supply.
+ *
+ * @param seconds Duration of the outage.
+ *
+ * @details
+ * If battery backup is enabled (VBATEN), the power-down time is captured (if PWRFAIL is not already set), the clock keeps running for @p seconds, then the power-up time is captured and PWRFAIL is set. Without battery backup the device loses its registers and SRAM as with twi_host_reset(), the EEPROM and the statistics are kept.
+ */
+void twi_host_powerfail(unsigned long seconds)
+{
+    if(!(twi_host_registers[TWI_HOST_RTCWKDAY] & TWI_HOST_VBATEN_bm))
+    {
+        twi_host_startup();
+        return;
+    }
+
+    unsigned char captured = (twi_host_registers[TWI_HOST_RTCWKDAY] & TWI_HOST_PWRFAIL_bm);
+
+    if(!captured)
+    {
+        twi_host_stamp(TWI_HOST_PWRDN);
+    }
+
+    for(; seconds; seconds--)
+    {
+        if(twi_host_running())
+        {
+            twi_host_tick();
+        }
+    }
+
+    if(!captured)
+    {
+        twi_host_stamp(TWI_HOST_PWRUP);
+        twi_host_registers[TWI_HOST_RTCWKDAY] |= TWI_HOST_PWRFAIL_bm;
+    }
+}
+
+/**
+ * @brief Reads a byte of the simulated EEPROM without a bus access.
+ *
+ * @param address EEPROM address (array 0x00 to 0x7F, unique ID area 0xF0 to 0xF7).
+ *
+ * @return Stored byte, 0xFF for an erased or not implemented address.
+ */
+unsigned char twi_host_eeprom_peek(unsigned char address)
+{
+    return twi_host_eeprom[address];
+}
+
+/**
+ * @brief Writes a byte of the simulated EEPROM without a bus access and without a write cycle.
+ *
+ * @param address EEPROM address (array 0x00 to 0x7F, unique ID area 0xF0 to 0xF7).
+ * @param data Byte to store, e.g. the pre-programmed EUI of an MCP79411 or MCP79412 in the unique ID area.
+ */
+void twi_host_eeprom_poke(unsigned char address, unsigned char data)
+{
+    twi_host_eeprom[address] = data;
+}
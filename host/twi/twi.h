@@ -0,0 +1,165 @@
+/**
+ * @file twi.h
+ * @brief Header file of the host TWI/I2C hardware abstraction layer with a simulated MCP7940.
+ *
+ * This file provides the TWI/I2C primitives expected by the MCP7940 driver for builds on a development host (@c MCP7940_HAL_PLATFORM set to @c host). Instead of driving a bus, the primitives operate on a register-file model of an MCP7940 that keeps time and of the EEPROM of the MCP7941x, and count every bus event, so the driver can be benchmarked and regression tested without hardware.
+ *
+ * @author g.raf
+ * @date 2026-10-14
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/drivers-rtc-mcp7940 "MCP7940 RTC driver library"
+ */
+
+#ifndef TWI_H_
+#define TWI_H_
+
+    #ifndef TWI_HOST_ADDRESS
+        /**
+         * @def TWI_HOST_ADDRESS
+         * @brief 7-bit TWI/I2C address at which the simulated MCP7940 answers.
+         *
+         * @note If TWI_HOST_ADDRESS is not explicitly defined in the project configuration, it defaults to 0x6F (see @c MCP7940_ADDRESS).
+         */
+        #define TWI_HOST_ADDRESS 0x6F
+    #endif
+
+    #ifndef TWI_HOST_EEPROM_ADDRESS
+        /**
+         * @def TWI_HOST_EEPROM_ADDRESS
+         * @brief 7-bit TWI/I2C address at which the simulated EEPROM of the MCP7941x answers.
+         *
+         * @note If TWI_HOST_EEPROM_ADDRESS is not explicitly defined in the project configuration, it defaults to 0x57 (see @c MCP7940_EEPROM_ADDRESS).
+         */
+        #define TWI_HOST_EEPROM_ADDRESS 0x57
+    #endif
+
+    #ifndef TWI_HOST_EEPROM_CYCLE_US
+        /**
+         * @def TWI_HOST_EEPROM_CYCLE_US
+         * @brief Duration of a write cycle of the simulated EEPROM in microseconds.
+         *
+         * The write cycle starts with the stop condition of a write that transferred data bytes. Until it has elapsed, the EEPROM does not acknowledge its address.
+         *
+         * @note If TWI_HOST_EEPROM_CYCLE_US is not explicitly defined in the project configuration, it defaults to 5000 us (maximum write cycle time of the MCP7941x).
+         */
+        #define TWI_HOST_EEPROM_CYCLE_US 5000UL
+    #endif
+
+    #ifndef TWI_HOST_FREQUENCY
+        /**
+         * @def TWI_HOST_FREQUENCY
+         * @brief Simulated TWI/I2C clock frequency in Hz.
+         *
+         * Every start or stop condition advances the simulated time by one bit time, every address or data byte by nine bit times (including the acknowledge).
+         *
+         * @note If TWI_HOST_FREQUENCY is not explicitly defined in the project configuration, it defaults to 100000 Hz (standard mode).
+         */
+        #define TWI_HOST_FREQUENCY 100000UL
+    #endif
+
+    /**
+     * @def TWI_HOST_REGISTERS
+     * @brief Size of the simulated register file (RTCC registers 0x00 to 0x1F and SRAM 0x20 to 0x5F).
+     */
+    #define TWI_HOST_REGISTERS 0x60
+
+    /**
+     * @def TWI_HOST_EEPROM_SIZE
+     * @brief Size of the address space of the simulated EEPROM (array 0x00 to 0x7F, protected unique ID area 0xF0 to 0xF7).
+     */
+    #define TWI_HOST_EEPROM_SIZE 0x100
+
+    /**
+     * @enum TWI_Operation_t
+     * @brief Direction of a TWI/I2C transfer that is appended to the slave address.
+     */
+    enum TWI_Operation_t
+    {
+        TWI_WRITE = 0,  /**< Master transmits data to the slave */
+        TWI_READ        /**< Master receives data from the slave */
+    };
+    /**
+     * @typedef TWI_Operation
+     * @brief Alias for enum TWI_Operation_t.
+     */
+    typedef enum TWI_Operation_t TWI_Operation;
+
+    /**
+     * @enum TWI_Acknowledge_t
+     * @brief Answer of the master after a received data byte.
+     */
+    enum TWI_Acknowledge_t
+    {
+        TWI_ACK = 0,    /**< Further bytes are requested */
+        TWI_NACK        /**< The byte was the last one of the transfer */
+    };
+    /**
+     * @typedef TWI_Acknowledge
+     * @brief Alias for enum TWI_Acknowledge_t.
+     */
+    typedef enum TWI_Acknowledge_t TWI_Acknowledge;
+
+    /**
+     * @enum TWI_Status_t
+     * @brief Result of a TWI/I2C primitive.
+     */
+    enum TWI_Status_t
+    {
+        TWI_None = 0,   /**< The primitive completed and was acknowledged */
+        TWI_Nack,       /**< The slave did not acknowledge the address or data byte */
+        TWI_Error       /**< The primitive was issued in an invalid bus state (e.g. data without a start condition) */
+    };
+    /**
+     * @typedef TWI_Status
+     * @brief Alias for enum TWI_Status_t.
+     */
+    typedef enum TWI_Status_t TWI_Status;
+
+    /**
+     * @struct TWI_Host_Statistics_t
+     * @brief Bus events counted by the host TWI/I2C layer since the last twi_host_reset() or twi_host_clear().
+     */
+    struct TWI_Host_Statistics_t
+    {
+        unsigned long transactions; /**< Start conditions on an idle bus (a repeated start belongs to the running transaction) */
+        unsigned long starts;       /**< All start conditions including repeated starts */
+        unsigned long stops;        /**< Stop conditions */
+        unsigned long bytes;        /**< Address and data bytes on the bus */
+        unsigned long nacks;        /**< Address or data bytes that were not acknowledged */
+        unsigned long cycles;       /**< Write cycles of the simulated EEPROM */
+        unsigned long wait_ms;      /**< Time spent in twi_host_wait_ms() (e.g. the driver's fixed delay after a transaction) */
+        unsigned long time_us;      /**< Simulated time, bus transfer time included */
+    };
+    /**
+     * @typedef TWI_Host_Statistics
+     * @brief Alias for struct TWI_Host_Statistics_t.
+     */
+    typedef struct TWI_Host_Statistics_t TWI_Host_Statistics;
+
+    extern TWI_Host_Statistics twi_host_statistics;
+
+            void twi_init(void);
+      TWI_Status twi_start(void);
+      TWI_Status twi_address(unsigned char address, TWI_Operation operation);
+      TWI_Status twi_set(unsigned char data);
+      TWI_Status twi_get(unsigned char *data, TWI_Acknowledge acknowledge);
+            void twi_stop(void);
+
+            void twi_host_reset(void);
+            void twi_host_clear(void);
+   unsigned char twi_host_peek(unsigned char address);
+            void twi_host_poke(unsigned char address, unsigned char data);
+            void twi_host_elapse(unsigned long microseconds);
+            void twi_host_wait_ms(unsigned int ms);
+            void twi_host_nack(unsigned char count);
+            void twi_host_powerfail(unsigned long seconds);
+   unsigned char twi_host_eeprom_peek(unsigned char address);
+            void twi_host_eeprom_poke(unsigned char address, unsigned char data);
+
+#endif /* TWI_H_ */
@@ -54,535 +54,3235 @@ const char* mcp7940_weekday_string(unsigned char day)
     return weeksdays[(0x07 & (day - 1))];
 }
 
-static void mcp7940_write(unsigned char address, unsigned char data)
-{
-    twi_start();
-    twi_address(MCP7940_ADDRESS, TWI_WRITE);
-    twi_set(address);
-    twi_set(data);
-    twi_stop();
-    
-    systick_timer_wait_ms(MCP7940_IO_TIMEOUT_MS);
-}
+#ifdef MCP7940_MULTI_DEVICE
+    static MCP7940_Error mcp7940_twi_start(void)
+    {
+        return MCP7940_TWI_ERROR(twi_start());
+    }
 
-static unsigned char mcp7940_read(unsigned char address)
-{
-    unsigned char temp;
-    
-    twi_start();
-    twi_address(MCP7940_ADDRESS, TWI_WRITE);
-    twi_set(address);
-    twi_address(MCP7940_ADDRESS, TWI_READ);
-    twi_get(&temp, TWI_NACK);
-    twi_stop();
-    
-    systick_timer_wait_ms(MCP7940_IO_TIMEOUT_MS);
-    
-    return temp;
-}
+    static MCP7940_Error mcp7940_twi_address(unsigned char address, unsigned char operation)
+    {
+        return MCP7940_TWI_ERROR(twi_address(address, operation));
+    }
 
-static unsigned char mcp7940_tobinary(unsigned char value, unsigned char mask)
-{
-    return (((mask & value)>>4) * 10UL + (0x0F & value));
-}
+    static MCP7940_Error mcp7940_twi_set(unsigned char data)
+    {
+        return MCP7940_TWI_ERROR(twi_set(data));
+    }
 
-static unsigned char mcp7940_data(unsigned char address, unsigned char mask)
-{
-    return mcp7940_tobinary(mcp7940_read(address), mask);
-}
+    static MCP7940_Error mcp7940_twi_get(unsigned char *data, unsigned char acknowledge)
+    {
+        return MCP7940_TWI_ERROR(twi_get(data, acknowledge));
+    }
 
-static void mcp7940_battery(MCP7940_Mode mode)
-{
-    unsigned char temp = mcp7940_read(MCP7940_RTCWKDAY);
-    
-    if(mode == MCP7940_Mode_Enable)
+    static void mcp7940_twi_stop(void)
     {
-        mcp7940_write(MCP7940_RTCWKDAY, (MCP7940_VBATEN_bm | temp));
-        return;
+        twi_stop();
     }
-    mcp7940_write(MCP7940_RTCWKDAY, ((~MCP7940_VBATEN_bm) & temp));
-}
 
-/**
- * @brief Initializes the MCP7940 RTC with battery backup, MFP mode, and oscillator settings.
- *
- * @details
- * This function configures the MCP7940 device according to the compile-time configuration macros. It first enables or disables the battery backup feature using mcp7940_battery() depending on MCP7940_BATTERY_BACKUP_EN. It then reads the current CONTROL register, preserves the EXTOSC bit, and updates control flags related to coarse trimming (MCP7940_CSTRIM_bm), square-wave output and prescaler (MCP7940_SQWEN_bm and MCP7940_MFP_SQUARE_WAVE_PRESCALER) or alarm mode (MCP7940_MFP_ALARM_MODE), depending on MCP7940_SQW_CRSTRIM_EN and MCP7940_MFP_MODE. Finally, it enables the RTC oscillator via mcp7940_oscillator(), allowing the device to begin timekeeping.
- */
-void mcp7940_init(void)
-{
-    #ifdef MCP7940_BATTERY_BACKUP_EN
-        mcp7940_battery(MCP7940_Mode_Enable);
-    #else
-        mcp7940_battery(MCP7940_Mode_Disable);
+    #if (MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME) || defined(MCP7940_ASYNC_EN)
+        static unsigned char mcp7940_twi_busy(void)
+        {
+            return (MCP7940_TWI_BUSY() ? 1 : 0);
+        }
     #endif
 
-    unsigned char temp = mcp7940_read(MCP7940_CONTROL) & MCP7940_EXTOSC_bm;
-    
-    mcp7940_write(MCP7940_CONTROL, (temp
-    #ifdef MCP7940_SQW_CRSTRIM_EN
-        | MCP7940_CSTRIM_bm
-    #endif
+    /**
+     * @brief Bus operations of the TWI/I2C hardware abstraction layer selected with @c MCP7940_HAL_PLATFORM.
+     *
+     * @details
+     * This instance is used by the default device @c mcp7940_device. Devices on a different bus need their own ::MCP7940_Bus with functions that drive that bus and are attached with mcp7940_dev_setup().
+     */
+    const MCP7940_Bus mcp7940_twi = {
+        mcp7940_twi_start,
+        mcp7940_twi_address,
+        mcp7940_twi_set,
+        mcp7940_twi_get,
+        mcp7940_twi_stop,
+        #if (MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME) || defined(MCP7940_ASYNC_EN)
+            mcp7940_twi_busy
+        #else
+            0
+        #endif
+    };
 
-    #if MCP7940_MFP_MODE == MCP7940_MFP_MODE_SQUARE_WAVE
-        | MCP7940_SQWEN_bm
+    #define MCP7940_BUS_START(device)              ((device)->bus->start())
+    #define MCP7940_BUS_ADDRESS(device, operation) ((device)->bus->address((device)->address, (operation)))
+    #define MCP7940_BUS_SET(device, data)          ((device)->bus->set(data))
+    #define MCP7940_BUS_GET(device, data, ack)     ((device)->bus->get((data), (ack)))
+    #define MCP7940_BUS_STOP(device)               ((device)->bus->stop())
+    #define MCP7940_BUS_BUSY(device)               ((device)->bus->busy && (device)->bus->busy())
 
-        #ifndef MCP7940_SQW_CRSTRIM_EN
-            | MCP7940_MFP_SQUARE_WAVE_PRESCALER
-        #endif
-    #elif MCP7940_MFP_MODE == MCP7940_MFP_MODE_ALARM
-        | MCP7940_MFP_ALARM_MODE
-    #endif
-    ));
-    
-    mcp7940_oscillator(MCP7940_Mode_Enable);
-}
+    #define MCP7940_BUS_SLAVE(device, slave, operation)   ((device)->bus->address((slave), (operation)))
+#else
+    // Single device: the HAL is called directly, so the handle only carries the cached state
+    #define MCP7940_BUS_START(device)              MCP7940_TWI_ERROR(twi_start())
+    #define MCP7940_BUS_ADDRESS(device, operation) MCP7940_TWI_ERROR(twi_address(MCP7940_ADDRESS, (operation)))
+    #define MCP7940_BUS_SET(device, data)          MCP7940_TWI_ERROR(twi_set(data))
+    #define MCP7940_BUS_GET(device, data, ack)     MCP7940_TWI_ERROR(twi_get((data), (ack)))
+    #define MCP7940_BUS_STOP(device)               twi_stop()
+    #define MCP7940_BUS_BUSY(device)               MCP7940_TWI_BUSY()
 
-/**
- * @brief Configures the MCP7940 oscillator trimming value and verifies the write.
- *
- * @param mode Selects the trim direction, using a value from ::MCP7940_Trim:
- * - `MCP7940_Trim_Substract` to subtract clock cycles (correct a fast clock).
- * - `MCP7940_Trim_Add` to add clock cycles (correct a slow clock).
- *
- * @param value Raw trim magnitude to apply to the OSCTRIM register. Only the lower 7 bits (bit 6:0) are used as the trim value; bit 7 is set or cleared internally by this function according to @p mode to encode the sign of the adjustment. A value of 0 disables digital trimming.
- *
- * @return Returns one of the following error codes:
- * - `MCP7940_Error_None` if the OSCTRIM register was written successfully and a subsequent readback matches the programmed value.
- * - `MCP7940_Error_Fail` if the readback of OSCTRIM does not match, indicating a possible I2C communication or device error.
- *
- * @details
- * This function masks @p value to seven bits, applies the sign bit according to the selected trim @p mode, and writes the resulting byte to the MCP7940 OSCTRIM register to adjust the RTC oscillator frequency. It then reads back the OSCTRIM register and compares it to the written value to confirm that the configuration was accepted by the device.
- */
-MCP7940_Error mcp7940_trimming(MCP7940_Trim mode, unsigned char value)
-{
-    value = (value & 0x7F);
+    #define MCP7940_BUS_SLAVE(device, slave, operation)   MCP7940_TWI_ERROR(twi_address((slave), (operation)))
+#endif
 
-    if(mode == MCP7940_Trim_Add)
+#if MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME
+    /**
+     * @brief Selects the wait strategy applied after each MCP7940 bus transaction at runtime.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param mode Wait strategy, using a value from ::MCP7940_Wait:
+     * - `MCP7940_Wait_Delay` blocks for @c MCP7940_IO_TIMEOUT_MS after every transaction (default).
+     * - `MCP7940_Wait_Poll` polls @c MCP7940_TWI_BUSY (the @c busy operation of the ::MCP7940_Bus with @c MCP7940_MULTI_DEVICE) until the bus is idle, at most @c MCP7940_IO_POLL_LIMIT times.
+     * - `MCP7940_Wait_None` starts the next transaction immediately.
+     *
+     * @details
+     * This function is available only when @c MCP7940_IO_WAIT is set to @c MCP7940_IO_WAIT_RUNTIME at compile time. Since the MCP7940 RTCC and SRAM have no write cycle time, `MCP7940_Wait_Poll` or `MCP7940_Wait_None` reduce a register access from at least one millisecond to the pure bus transfer time.
+     */
+    void mcp7940_dev_waitmode(MCP7940_Device *device, MCP7940_Wait mode)
     {
-        value |= 0x80;
+        device->wait = mode;
     }
+#endif
 
-    mcp7940_write(MCP7940_OSCTRIM, value);
-    
-    if(mcp7940_read(MCP7940_OSCTRIM) == value)
-    {
-        return MCP7940_Error_None;
-    }
-    return MCP7940_Error_Fail;
+static MCP7940_Error mcp7940_trace(MCP7940_Trace operation, MCP7940_Error status)
+{
+    (void)operation;
+    MCP7940_TRACE_END(operation, status);
+    return status;
 }
 
-/**
- * @brief Enables or disables the MCP7940 RTC oscillator or external clock input.
- *
- * @param mode Selects the desired oscillator mode, using a value from ::MCP7940_Mode:
- * - `MCP7940_Mode_Enable` to start the oscillator or enable the external clock.
- * - `MCP7940_Mode_Disable` to stop the oscillator or disable the external clock.
- *
- * @details
- * Depending on the compile-time configuration, this function controls either the external oscillator input (MCP7940_USE_EXTOSC defined) by setting or clearing the EXTOSC bit in the CONTROL register, or the internal RTC oscillator by setting or clearing the ST (start oscillator) bit in the seconds register RTCSEC. The corresponding register is read first and then updated with the appropriate bit set or cleared while preserving the other bits.
- */
-void mcp7940_oscillator(MCP7940_Mode mode)
+static MCP7940_Error mcp7940_wait(MCP7940_Device *device)
 {
-    #ifdef MCP7940_USE_EXTOSC
-        unsigned char temp = mcp7940_read(MCP7940_CONTROL);
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Wait);
 
-        if(mode == MCP7940_Mode_Enable)
+    #if MCP7940_IO_WAIT == MCP7940_IO_WAIT_DELAY
+        (void)device;
+        systick_timer_wait_ms(MCP7940_IO_TIMEOUT_MS);
+    #elif MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME
+        switch (device->wait)
         {
-            mcp7940_write(MCP7940_CONTROL, (MCP7940_EXTOSC_bm | temp));
-            return;
+            case MCP7940_Wait_Delay:
+                systick_timer_wait_ms(MCP7940_IO_TIMEOUT_MS);
+            break;
+            case MCP7940_Wait_Poll:
+                for(unsigned int poll = 0; MCP7940_BUS_BUSY(device); poll++)
+                {
+                    // Wait until the bus returned to idle
+                    if(poll >= MCP7940_IO_POLL_LIMIT)
+                    {
+                        return mcp7940_trace(MCP7940_Trace_Wait, MCP7940_Error_Timeout);
+                    }
+                }
+            break;
+            default:
+            break;
         }
-        mcp7940_write(MCP7940_CONTROL, ((~MCP7940_EXTOSC_bm) & temp));
     #else
-        unsigned char temp = mcp7940_read(MCP7940_RTCSEC);
-
-        if(mode == MCP7940_Mode_Enable)
-        {
-            mcp7940_write(MCP7940_RTCSEC, (MCP7940_ST_bm | temp));
-            return;
-        }
-        mcp7940_write(MCP7940_RTCSEC, ((~MCP7940_ST_bm) & temp));
+        (void)device;
     #endif
+    return mcp7940_trace(MCP7940_Trace_Wait, MCP7940_Error_None);
 }
 
-/**
- * @brief Reads and returns the current MCP7940 status flags from the weekday register.
- *
- * @return A ::MCP7940_Status value containing a bitwise combination of:
- * - `MCP7940_Status_Oscillator_Running` if the OSCRUN bit is set, indicating that the oscillator is currently running.
- * - `MCP7940_Status_Power_Fail` if the PWRFAIL bit is set, indicating that a power-fail event has been logged and the corresponding time stamps are available.
- * - `MCP7940_Status_Battery_Enabled` if the VBATEN bit is set, indicating that battery backup mode is enabled.
- * 
- * If none of these bits are set, the function returns `MCP7940_Status_None`.
- *
- * @details
- * This function reads the RTCWKDAY register of the MCP7940 and masks out the OSCRUN, PWRFAIL, and VBATEN bits to construct an ::MCP7940_Status value. The resulting status can be used by higher-level code to determine whether the RTC oscillator is running, whether a power failure has occurred, and whether battery backup is configured.
- */
-MCP7940_Status mcp7940_status(void)
-{
-    return (mcp7940_read(MCP7940_RTCWKDAY) & (MCP7940_OSCRUN_bm | MCP7940_PWRFAIL_bm | MCP7940_VBATEN_bm));
-}
+#ifdef MCP7940_SHADOW_EN
+    #define MCP7940_SHADOW_NONE 0xFF
+
+    static unsigned char mcp7940_shadow_index(unsigned char address)
+    {
+        switch (address)
+        {
+            case MCP7940_RTCWKDAY:
+                return 0;
+            case MCP7940_CONTROL:
+                return 1;
+            case MCP7940_OSCTRIM:
+                return 2;
+            default:
+                return MCP7940_SHADOW_NONE;
+        }
+    }
 
-#if MCP7940_MFP_MODE == MCP7940_MFP_MODE_OUTPUT
     /**
-     * @brief Controls the MCP7940 MFP pin when configured as a general-purpose output.
+     * @brief Invalidates the shadow copies of the MCP7940 CONTROL, RTCWKDAY and OSCTRIM registers.
      *
-     * @param output Desired output mode for the MFP pin, using a value from ::MCP7940_Mode:
-     * - `MCP7940_Mode_Enable` drives the MFP pin active by setting the OUT bit in the CONTROL register.
-     * - `MCP7940_Mode_Disable` releases the MFP pin (open-drain inactive state) by clearing the OUT bit.
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
      *
      * @details
-     * This function is available only when @c MCP7940_MFP_MODE is set to @c MCP7940_MFP_MODE_OUTPUT at compile time. In this mode, the MFP pin behaves as an open-drain general-purpose output controlled by the OUT bit in the CONTROL register. The function reads the current CONTROL value, sets or clears the OUT bit according to @p output, and writes the updated value back, preserving all other control bits.
+     * This function is available only when @c MCP7940_SHADOW_EN is defined. It has to be called if another bus master or firmware modified one of the cached registers behind the driver's back. The next read-modify-write of an invalidated register reads it from the device again and refreshes the shadow copy.
      */
-    void mcp7940_mfp_output(MCP7940_Mode output)
-    {   
-        unsigned char temp = mcp7940_read(MCP7940_CONTROL);
-        
-        if(output)
-        {
-            mcp7940_write(MCP7940_CONTROL, (MCP7940_OUT_bm | temp));
-            return;
-        }
-        mcp7940_write(MCP7940_CONTROL, ((~MCP7940_OUT_bm) & temp));
+    void mcp7940_dev_shadow_invalidate(MCP7940_Device *device)
+    {
+        device->shadow_valid = 0;
     }
 #endif
 
-static unsigned char mcp7940_hour(MCP7940_Register data)
+static void mcp7940_shadow_update(MCP7940_Device *device, unsigned char address, const unsigned char *data, unsigned char length)
 {
-    unsigned char temp;
+    #ifdef MCP7940_SHADOW_EN
+        for(; length; length--)
+        {
+            unsigned char index = mcp7940_shadow_index(address++);
 
-    switch (data)
+            if(index != MCP7940_SHADOW_NONE)
+            {
+                device->shadow[index] = *data;
+                device->shadow_valid |= (1<<index);
+            }
+            data++;
+        }
+    #else
+        (void)device;
+        (void)address;
+        (void)data;
+        (void)length;
+    #endif
+}
+
+static MCP7940_Error mcp7940_attempt(MCP7940_Device *device, unsigned char address, const unsigned char *tx, unsigned char *rx, unsigned char length)
+{
+    MCP7940_Error error = MCP7940_BUS_START(device);
+
+    if(error == MCP7940_Error_None)
     {
-        case MCP7940_Register_Power_Down_Time:
-            temp = MCP7940_PWRDNHOUR;
-        break;
-        case MCP7940_Register_Power_Up_Time:
-            temp = MCP7940_PWRUPHOUR;
-        break;
-        default:
-            temp = MCP7940_RTCHOUR;
-        break;
+        error = MCP7940_BUS_ADDRESS(device, TWI_WRITE);
+    }
+    if(error == MCP7940_Error_None)
+    {
+        error = MCP7940_BUS_SET(device, address);
+    }
+
+    if(rx)
+    {
+        if(error == MCP7940_Error_None)
+        {
+            error = MCP7940_BUS_ADDRESS(device, TWI_READ);
+        }
+        while((error == MCP7940_Error_None) && length)
+        {
+            length--;
+            error = MCP7940_BUS_GET(device, rx++, (length ? TWI_ACK : TWI_NACK));
+        }
+    }
+    else
+    {
+        while((error == MCP7940_Error_None) && length)
+        {
+            length--;
+            error = MCP7940_BUS_SET(device, *tx++);
+        }
+    }
+    MCP7940_BUS_STOP(device);
+
+    if(error != MCP7940_Error_None)
+    {
+        return error;
     }
-    return mcp7940_data(temp, MCP7940_HRTEN_bm);
+    return mcp7940_wait(device);
 }
 
-static unsigned char mcp7940_minute(MCP7940_Register data)
+static MCP7940_Error mcp7940_transfer(MCP7940_Device *device, unsigned char address, const unsigned char *tx, unsigned char *rx, unsigned char length)
 {
-    unsigned char temp;
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Transfer);
 
-    switch (data)
+    MCP7940_Error error;
+    unsigned char retry = 0;
+
+    #ifdef MCP7940_ASYNC_EN
+        // A start condition would break into the queued transfer
+        if(mcp7940_async_busy())
+        {
+            return mcp7940_trace(MCP7940_Trace_Transfer, MCP7940_Error_Fail);
+        }
+    #endif
+
+    do
     {
-        case MCP7940_Register_Power_Down_Time:
-            temp = MCP7940_PWRDNMIN;
-        break;
-        case MCP7940_Register_Power_Up_Time:
-            temp = MCP7940_PWRUPMIN;
-        break;
-        default:
-            temp = MCP7940_RTCMIN;
-        break;
+        error = mcp7940_attempt(device, address, tx, rx, length);
+    } while(((error == MCP7940_Error_Nack) || (error == MCP7940_Error_Arbitration)) && (retry++ < MCP7940_IO_RETRIES));
+
+    if(error == MCP7940_Error_None)
+    {
+        mcp7940_shadow_update(device, address, (rx ? rx : tx), length);
     }
-    return mcp7940_data(temp, MCP7940_MINTEN_bm);
+    return mcp7940_trace(MCP7940_Trace_Transfer, error);
 }
 
-static unsigned char mcp7940_second(void)
+static MCP7940_Error mcp7940_write(MCP7940_Device *device, unsigned char address, unsigned char data)
 {
-    return mcp7940_data(MCP7940_RTCSEC, MCP7940_SECTEN_bm);
+    return mcp7940_transfer(device, address, &data, 0, 1);
 }
 
-/**
- * @brief Reads the weekday value from the MCP7940 for the selected timestamp register set.
- *
- * @param data Selects which MCP7940 register block to read the weekday from, using a value from ::MCP7940_Register:
- * - `MCP7940_Register_Current_Time` to read the current weekday from RTCWKDAY.
- * - `MCP7940_Register_Power_Down_Time` to read the power-down weekday from PWRDNMTH.
- * - `MCP7940_Register_Power_Up_Time` to read the power-up weekday from PWRUPMTH.
- *
- * @return An unsigned 3-bit weekday value in the range 0–7, where the underlying MCP7940 encoding uses 1–7 for the day-of-week and 0 may be returned if the register contents are not yet initialized.
- *
- * @details
- * This function extracts the weekday field from the appropriate MCP7940 register depending on @p data. For the power-down and power-up timestamp registers, the weekday bits are located in the upper three bits of the month register (PWRDNMTH or PWRUPMTH) and are right-shifted by @c MCP7940_PWRWEEKDAY_bp after masking. For the current time, the weekday is read directly from the RTCWKDAY register and masked with 0x07 to return only the weekday bits.
- */
-unsigned char mcp7940_weekday(MCP7940_Register data)
+static MCP7940_Error mcp7940_read(MCP7940_Device *device, unsigned char address, unsigned char *data)
 {
-    switch (data)
-    {
-        case MCP7940_Register_Power_Down_Time:
-            return ((0xE0 & mcp7940_read(MCP7940_PWRDNMTH)) >> MCP7940_PWRWEEKDAY_bp);
-        case MCP7940_Register_Power_Up_Time:
-            return ((0xE0 & mcp7940_read(MCP7940_PWRUPMTH)) >> MCP7940_PWRWEEKDAY_bp);
-        default:
-            return (0x07 & mcp7940_read(MCP7940_RTCWKDAY));
-    }
+    return mcp7940_transfer(device, address, 0, data, 1);
 }
 
-static unsigned char mcp7940_day(MCP7940_Register data)
+static MCP7940_Error mcp7940_read_burst(MCP7940_Device *device, unsigned char address, unsigned char *data, unsigned char length)
 {
-    unsigned char temp;
+    return mcp7940_transfer(device, address, 0, data, length);
+}
 
-    switch (data)
-    {
-        case MCP7940_Register_Power_Down_Time:
-            temp = MCP7940_PWRDNDATE;
-        break;
-        case MCP7940_Register_Power_Up_Time:
-            temp = MCP7940_PWRUPDATE;
-        break;
-        default:
-            temp = MCP7940_RTCDATE;
-        break;
-    }
-    return mcp7940_data(temp, MCP7940_DATETEN_bm);
+static MCP7940_Error mcp7940_write_burst(MCP7940_Device *device, unsigned char address, const unsigned char *data, unsigned char length)
+{
+    return mcp7940_transfer(device, address, data, 0, length);
 }
 
-static unsigned char mcp7940_month(MCP7940_Register data)
+static MCP7940_Error mcp7940_load(MCP7940_Device *device, unsigned char address, unsigned char *data)
 {
-    unsigned char temp;
+    #ifdef MCP7940_SHADOW_EN
+        unsigned char index = mcp7940_shadow_index(address);
 
-    switch (data)
-    {
-        case MCP7940_Register_Power_Down_Time:
-            temp = MCP7940_PWRDNMTH;
-        break;
-        case MCP7940_Register_Power_Up_Time:
-            temp = MCP7940_PWRUPMTH;
-        break;
-        default:
-            temp = MCP7940_RTCMTH;
-        break;
-    }
-    return mcp7940_data(temp, MCP7940_MTHTEN_bm);
+        if((index != MCP7940_SHADOW_NONE) && (device->shadow_valid & (1<<index)))
+        {
+            *data = device->shadow[index];
+            return MCP7940_Error_None;
+        }
+    #endif
+    return mcp7940_read(device, address, data);
 }
 
-static unsigned char mcp7940_year(void)
+static unsigned char mcp7940_tobinary(unsigned char value, unsigned char mask)
 {
-    return mcp7940_data(MCP7940_RTCYEAR, MCP7940_YRTEN_bm);
+    // tens * 10 as (tens * 8) + (tens * 2), so the conversion stays byte-wide on 8-bit targets
+    unsigned char tens = ((mask & value)>>4);
+    return ((tens<<3) + (tens<<1) + (0x0F & value));
 }
 
-/**
- * @brief Reads hour, minute, and second fields from the MCP7940 into a FORMAT_Time structure.
- *
- * @param time Pointer to a ::FORMAT_Time structure that will be populated with time information from the MCP7940 registers. On return:
- * - @c time->hour contains the decoded hour value.
- * - @c time->minute contains the decoded minute value.
- * - @c time->second contains the decoded second value for current time, or 0 for power-up/power-down timestamp selections.
- *
- * @param reg Selects which MCP7940 register set to read, using a value from ::MCP7940_Register:
- * - `MCP7940_Register_Current_Time` to read the live time registers.
- * - `MCP7940_Register_Power_Down_Time` to read the power-down timestamp.
- * - `MCP7940_Register_Power_Up_Time` to read the power-up timestamp.
- *
- * @details
- * This function uses helper routines (mcp7940_hour(), mcp7940_minute(), and optionally mcp7940_second()) to extract the hour and minute from the selected MCP7940 time/timestamp registers and write them into @p time. For the current time selection, seconds are also read via mcp7940_second(). For power-down and power-up timestamp registers, the seconds field is not read and @c time->second is set to 0, since those registers do not store a separate seconds value in this implementation.
- */
-void mcp7940_time(FORMAT_Time *time, MCP7940_Register reg)
-{
-    time->hour = mcp7940_hour(reg);
-    time->minute = mcp7940_minute(reg);
+#if defined(MCP7940_RECORD_EN) || defined(MCP7940_CALIBRATION_EN)
+    static unsigned char mcp7940_crc8(const unsigned char *data, unsigned char length)
+    {
+        unsigned char crc = 0xFF;
+
+        while(length--)
+        {
+            crc ^= *data++;
+
+            for(unsigned char bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x80) ? ((crc << 1) ^ 0x07) : (crc << 1);
+            }
+        }
+        return crc;
+    }
+#endif
+
+#ifdef MCP7940_RECORD_EN
+    #define MCP7940_RECORD_SLOT (MCP7940_RECORD_SIZE + 2)
+    #define MCP7940_RECORD_NONE 0xFF
 
-    if(reg == MCP7940_Register_Current_Time)
+    #if (MCP7940_RECORD_OFFSET + (2 * MCP7940_RECORD_SLOT)) > MCP7940_SRAM_SIZE
+        #error "MCP7940 record store does not fit into the SRAM (check MCP7940_RECORD_SIZE/MCP7940_RECORD_OFFSET)"
+    #endif
+
+    static unsigned char mcp7940_record_valid(const unsigned char *slot)
     {
-        time->second = mcp7940_second();
-        return;
+        return (mcp7940_crc8(slot, (MCP7940_RECORD_SIZE + 1)) == slot[MCP7940_RECORD_SIZE + 1]);
     }
-    time->second = 0;
-}
 
+    static MCP7940_Error mcp7940_record_recover(MCP7940_Device *device)
+    {
+        unsigned char buffer[2 * MCP7940_RECORD_SLOT];
+        unsigned char slot  = MCP7940_RECORD_NONE;
+        MCP7940_Error error = mcp7940_dev_sram_read(device, MCP7940_RECORD_OFFSET, buffer, sizeof(buffer));
+
+        if(error != MCP7940_Error_None)
+        {
+            device->record_slot = MCP7940_RECORD_NONE;
+            return error;
+        }
+
+        for(unsigned char index = 0; index < 2; index++)
+        {
+            const unsigned char *temp = &buffer[index * MCP7940_RECORD_SLOT];
+
+            if(!mcp7940_record_valid(temp))
+            {
+                continue;
+            }
+
+            // Serial number arithmetic keeps the comparison valid across a sequence wrap-around
+            if((slot == MCP7940_RECORD_NONE) || ((signed char)(temp[0] - buffer[slot * MCP7940_RECORD_SLOT]) > 0))
+            {
+                slot = index;
+            }
+        }
+
+        device->record_slot = slot;
+
+        if(slot == MCP7940_RECORD_NONE)
+        {
+            device->record_sequence = 0;
+            return MCP7940_Error_None;
+        }
+
+        device->record_sequence = buffer[slot * MCP7940_RECORD_SLOT];
+
+        for(unsigned char i = 0; i < MCP7940_RECORD_SIZE; i++)
+        {
+            device->record_data[i] = buffer[(slot * MCP7940_RECORD_SLOT) + 1 + i];
+        }
+        return MCP7940_Error_None;
+    }
+#endif
 
 /**
- * @brief Reads day, month, and year fields from the MCP7940 into a FORMAT_Date structure.
- *
- * @param date Pointer to a ::FORMAT_Date structure that will be populated with calendar information from the MCP7940 registers. On return:
- * - @c date->day contains the decoded day-of-month value.
- * - @c date->month contains the decoded month value.
- * - @c date->year contains the decoded year value for current time, or 0 for power-up/power-down timestamp selections.
- *
- * @param reg Selects which MCP7940 register set to read, using a value from ::MCP7940_Register:
- * - `MCP7940_Register_Current_Time` to read the live calendar date.
- * - `MCP7940_Register_Power_Down_Time` to read the power-down timestamp date.
- * - `MCP7940_Register_Power_Up_Time` to read the power-up timestamp date.
+ * @brief Default MCP7940 device used by the singleton API (mcp7940_init(), mcp7940_datetime(), ...).
  *
  * @details
- * This function uses helper routines (mcp7940_day(), mcp7940_month(), and optionally mcp7940_year()) to extract the calendar date fields from the selected MCP7940 time or timestamp registers and write them into @p date. For the current time selection, the year field is read from the device via mcp7940_year(). For power-down and power-up timestamp registers, the year field is not read and @c date->year is set to 0, as this implementation does not associate a stored year with those timestamp records.
+ * With @c MCP7940_MULTI_DEVICE it is attached to the bus operations ::mcp7940_twi and @c MCP7940_ADDRESS, otherwise the bus and address are fixed at compile time and the handle only holds the cached device state.
  */
-void mcp7940_date(FORMAT_Date *date, MCP7940_Register reg)
-{
-    date->day = mcp7940_day(reg);
-    date->month = mcp7940_month(reg);
+MCP7940_Device mcp7940_device = {
+    #ifdef MCP7940_MULTI_DEVICE
+        .bus     = &mcp7940_twi,
+        .address = MCP7940_ADDRESS,
+    #endif
 
-    if(reg == MCP7940_Register_Current_Time)
+    #ifdef MCP7940_RECORD_EN
+        .record_slot = MCP7940_RECORD_NONE,
+    #endif
+    .alarm_wkday = { 0, 0 }
+};
+
+#ifdef MCP7940_MULTI_DEVICE
+    /**
+     * @brief Attaches an MCP7940 device handle to a bus and resets its cached state.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle to set up.
+     *
+     * @param bus Pointer to the ::MCP7940_Bus operations of the bus the device is connected to (e.g. ::mcp7940_twi). The structure has to remain valid as long as the handle is used.
+     *
+     * @param address 7-bit TWI/I2C address of the device (@c MCP7940_ADDRESS for a standard MCP7940).
+     *
+     * @details
+     * This function is available only when @c MCP7940_MULTI_DEVICE is defined and has to be called once for every additional device before mcp7940_dev_init(). The default device @c mcp7940_device is already set up statically. Several handles may share one ::MCP7940_Bus as long as the devices use different addresses.
+     */
+    void mcp7940_dev_setup(MCP7940_Device *device, const MCP7940_Bus *bus, unsigned char address)
     {
-        date->year = mcp7940_year();
-        return;
+        device->bus = bus;
+        device->address = address;
+
+        #if MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME
+            device->wait = MCP7940_Wait_Delay;
+        #endif
+
+        #ifdef MCP7940_SHADOW_EN
+            device->shadow_valid = 0;
+        #endif
+
+        #ifdef MCP7940_RECORD_EN
+            device->record_slot = MCP7940_RECORD_NONE;
+            device->record_sequence = 0;
+        #endif
+
+        #ifdef MCP7940_QUEUE_EN
+            device->queue_length = 0;
+        #endif
+
+        #ifdef MCP7940_CALIBRATION_EN
+            device->calibration_epoch = 0;
+        #endif
+
+        #ifdef MCP7940_TICK_EN
+            device->tick_valid = 0;
+        #endif
+        device->alarm_wkday[MCP7940_Alarm_0] = 0;
+        device->alarm_wkday[MCP7940_Alarm_1] = 0;
     }
-    date->year = 0;
+#endif
+
+static unsigned char mcp7940_control(unsigned char control)
+{
+    return ((control & MCP7940_EXTOSC_bm)
+    #ifdef MCP7940_SQW_CRSTRIM_EN
+        | MCP7940_CSTRIM_bm
+    #endif
+
+    #if MCP7940_MFP_MODE == MCP7940_MFP_MODE_SQUARE_WAVE
+        | MCP7940_SQWEN_bm
+
+        #ifndef MCP7940_SQW_CRSTRIM_EN
+            | MCP7940_MFP_SQUARE_WAVE_PRESCALER
+        #endif
+    #elif MCP7940_MFP_MODE == MCP7940_MFP_MODE_ALARM
+        | MCP7940_MFP_ALARM_MODE
+    #endif
+    );
 }
 
+#ifdef MCP7940_INIT_FAST
+    static MCP7940_Error mcp7940_configure(MCP7940_Device *device)
+    {
+        unsigned char buffer[MCP7940_OSCTRIM + 1];
+        unsigned char target[MCP7940_OSCTRIM + 1];
+        unsigned char first = sizeof(buffer);
+        unsigned char last = 0;
+
+        #ifdef MCP7940_SHADOW_EN
+            mcp7940_dev_shadow_invalidate(device);
+        #endif
+
+        MCP7940_Error error = mcp7940_read_burst(device, MCP7940_RTCSEC, buffer, sizeof(buffer));
+
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+
+        for(unsigned char i = 0; i < sizeof(buffer); i++)
+        {
+            target[i] = buffer[i];
+        }
+
+        #if defined(MCP7940_BATTERY_BACKUP_EN)
+            target[MCP7940_RTCWKDAY] |= MCP7940_VBATEN_bm;
+        #elif defined(MCP7940_HAS_BATTERY)
+            target[MCP7940_RTCWKDAY] &= ~MCP7940_VBATEN_bm;
+        #endif
+
+        target[MCP7940_CONTROL] = mcp7940_control(buffer[MCP7940_CONTROL]);
+
+        #ifdef MCP7940_USE_EXTOSC
+            target[MCP7940_CONTROL] |= MCP7940_EXTOSC_bm;
+        #else
+            target[MCP7940_RTCSEC] |= MCP7940_ST_bm;
+        #endif
+
+        for(unsigned char i = 0; i < sizeof(buffer); i++)
+        {
+            if(target[i] != buffer[i])
+            {
+                first = (first < i) ? first : i;
+                last = i;
+            }
+        }
+
+        if(first > last)
+        {
+            return MCP7940_Error_None;
+        }
+
+        // A stopped oscillator cannot advance the time registers in between, so the whole span is rewritten at once
+        if(!(buffer[MCP7940_RTCWKDAY] & MCP7940_OSCRUN_bm))
+        {
+            return mcp7940_write_burst(device, first, &target[first], (last - first + 1));
+        }
+
+        for(unsigned char i = first; (error == MCP7940_Error_None) && (i <= last); i++)
+        {
+            if(target[i] != buffer[i])
+            {
+                error = mcp7940_write(device, i, target[i]);
+            }
+        }
+        return error;
+    }
+#endif
+
+#if defined(MCP7940_HAS_BATTERY) && !defined(MCP7940_INIT_FAST)
+    static MCP7940_Error mcp7940_battery(MCP7940_Device *device, MCP7940_Mode mode)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Battery);
+
+        unsigned char temp;
+        MCP7940_Error error = mcp7940_load(device, MCP7940_RTCWKDAY, &temp);
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Battery, error);
+        }
+        
+        // PWRFAIL can only be cleared, writing 1 keeps a power failure latched since the value was cached
+        temp |= MCP7940_PWRFAIL_bm;
+
+        if(mode == MCP7940_Mode_Enable)
+        {
+            return mcp7940_trace(MCP7940_Trace_Battery, mcp7940_write(device, MCP7940_RTCWKDAY, (MCP7940_VBATEN_bm | temp)));
+        }
+        return mcp7940_trace(MCP7940_Trace_Battery, mcp7940_write(device, MCP7940_RTCWKDAY, ((~MCP7940_VBATEN_bm) & temp)));
+    }
+#endif
+
 /**
- * @brief Reads both time and date from the MCP7940 into a FORMAT_DateTime structure.
+ * @brief Initializes the MCP7940 RTC with battery backup, MFP mode, and oscillator settings.
  *
- * @param datetime Pointer to a ::FORMAT_DateTime structure that will be filled with the time and date fields obtained from the MCP7940 registers corresponding to @p reg. On return, @c datetime->time and @c datetime->date contain the decoded values.
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
  *
- * @param reg Selects which MCP7940 register set to read, using a value from ::MCP7940_Register:
- * - `MCP7940_Register_Current_Time` to read the live date and time.
- * - `MCP7940_Register_Power_Down_Time` to read the power-down timestamp.
- * - `MCP7940_Register_Power_Up_Time` to read the power-up timestamp.
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the device has been configured.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a bus transaction failed (the remaining steps are skipped).
  *
  * @details
- * This function is a convenience wrapper that combines mcp7940_time() and mcp7940_date() to populate a ::FORMAT_DateTime instance in a single call. It first reads the time portion into @c datetime->time, then reads the date portion into @c datetime->date, using the same @p reg selection for both operations to keep time and date information consistent.
+ * This function configures the MCP7940 device according to the compile-time configuration macros. It first enables or disables the battery backup feature using mcp7940_battery() depending on MCP7940_BATTERY_BACKUP_EN (left out for variants without battery backup, see @c MCP7940_VARIANT). It then reads the current CONTROL register, preserves the EXTOSC bit, and updates control flags related to coarse trimming (MCP7940_CSTRIM_bm), square-wave output and prescaler (MCP7940_SQWEN_bm and MCP7940_MFP_SQUARE_WAVE_PRESCALER) or alarm mode (MCP7940_MFP_ALARM_MODE), depending on MCP7940_SQW_CRSTRIM_EN and MCP7940_MFP_MODE. Finally, it enables the RTC oscillator via mcp7940_oscillator(), allowing the device to begin timekeeping. With @c MCP7940_SHADOW_EN the registers RTCSEC to OSCTRIM are read in one burst first, which fills the shadow copies of RTCWKDAY, CONTROL and OSCTRIM so that the following read-modify-write sequences only cost a single write each. With @c MCP7940_INIT_FAST the registers RTCSEC to OSCTRIM are read in one burst instead and only the registers that differ from the configuration are written, so an already configured device costs a single transaction. With @c MCP7940_RECORD_EN both SRAM record slots are read in one transaction and the newest valid record is kept for mcp7940_record_restore(). An invalid stored record or calibration is not treated as an error.
  */
-void mcp7940_datetime(FORMAT_DateTime *datetime, MCP7940_Register reg)
+MCP7940_Error mcp7940_dev_init(MCP7940_Device *device)
 {
-    mcp7940_time(&datetime->time, reg);
-    mcp7940_date(&datetime->date, reg);
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Init);
+
+    #ifdef MCP7940_INIT_FAST
+        MCP7940_Error error = mcp7940_configure(device);
+    #else
+        MCP7940_Error error = MCP7940_Error_None;
+        unsigned char temp;
+
+        #ifdef MCP7940_SHADOW_EN
+            unsigned char buffer[MCP7940_OSCTRIM + 1];
+
+            mcp7940_dev_shadow_invalidate(device);
+            error = mcp7940_read_burst(device, MCP7940_RTCSEC, buffer, sizeof(buffer));
+        #endif
+
+        #if defined(MCP7940_BATTERY_BACKUP_EN)
+            if(error == MCP7940_Error_None)
+            {
+                error = mcp7940_battery(device, MCP7940_Mode_Enable);
+            }
+        #elif defined(MCP7940_HAS_BATTERY)
+            if(error == MCP7940_Error_None)
+            {
+                error = mcp7940_battery(device, MCP7940_Mode_Disable);
+            }
+        #endif
+
+        if(error == MCP7940_Error_None)
+        {
+            error = mcp7940_load(device, MCP7940_CONTROL, &temp);
+        }
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Init, error);
+        }
+        error = mcp7940_write(device, MCP7940_CONTROL, mcp7940_control(temp));
+
+        if(error == MCP7940_Error_None)
+        {
+            error = mcp7940_dev_oscillator(device, MCP7940_Mode_Enable);
+        }
+    #endif
+
+    #ifdef MCP7940_RECORD_EN
+        if(error == MCP7940_Error_None)
+        {
+            error = mcp7940_record_recover(device);
+        }
+    #endif
+
+    #ifdef MCP7940_CALIBRATION_EN
+        if(error == MCP7940_Error_None)
+        {
+            error = mcp7940_dev_calibration_restore(device);
+            error = (error == MCP7940_Error_Fail) ? MCP7940_Error_None : error;
+        }
+    #endif
+    return mcp7940_trace(MCP7940_Trace_Init, error);
 }
 
 /**
- * @brief Returns the current leap year status from the MCP7940 device.
+ * @brief Configures the MCP7940 oscillator trimming value and verifies the write.
  *
- * @return A ::MCP7940_LeapYear value derived from the MCP7940 leap-year field:
- * - `MCP7940_LeapYear_False` if the device indicates a non-leap year.
- * - `MCP7940_LeapYear_True` if the device indicates a leap year.
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
  *
- * @details
- * This function reads the leap-year indicator bits from the MCP7940 and masks and shifts them into the ::MCP7940_LeapYear enumeration domain. The returned value reflects the RTC’s internal leap-year status, which influences how February 29 is handled in the device’s calendar logic.
- */
-MCP7940_LeapYear mcp7940_leapyear(void)
-{
-    return ((0x07 & mcp7940_read(MCP7940_LPYR_bm))>>MCP7940_LPYR_bp);
-}
-
-/**
- * @brief Sets the MCP7940 weekday field in the RTCWKDAY register.
+ * @param mode Selects the trim direction, using a value from ::MCP7940_Trim:
+ * - `MCP7940_Trim_Substract` to subtract clock cycles (correct a fast clock).
+ * - `MCP7940_Trim_Add` to add clock cycles (correct a slow clock).
  *
- * @param weekday Zero-based weekday index to be written to the device. Valid values are:
- * - 0 for the first day of the week (mapped to device value 1),
- * - 1 for the second day of the week (mapped to device value 2),
- * - ...
- * - 6 for the seventh day of the week (mapped to device value 7).
- * 
- * Values greater than or equal to 7 are rejected.
+ * @param value Raw trim magnitude to apply to the OSCTRIM register. Only the lower 7 bits (bit 6:0) are used as the trim value; bit 7 is set or cleared internally by this function according to @p mode to encode the sign of the adjustment. A value of 0 disables digital trimming.
  *
  * @return Returns one of the following error codes:
- * - `MCP7940_Error_None` if @p weekday is within range and the RTCWKDAY register was updated.
- * - `MCP7940_Error_Fail` if @p weekday is out of range (>= 7) and the register is not modified.
+ * - `MCP7940_Error_None` if the OSCTRIM register was written successfully and a subsequent readback matches the programmed value.
+ * - `MCP7940_Error_Fail` if the readback of OSCTRIM does not match the programmed value.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the write or the readback failed on the bus.
  *
  * @details
- * This function programs the weekday field of the MCP7940 RTCWKDAY register. The MCP7940 encodes weekday values in the range 1–7, so the provided zero-based @p weekday is incremented by 1 and masked with 0x07 before being written. The existing upper bits of RTCWKDAY (such as VBATEN, PWRFAIL, and OSCRUN) are preserved by masking with 0xF8 and OR-ing in the new weekday value.
+ * This function masks @p value to seven bits, applies the sign bit according to the selected trim @p mode, and writes the resulting byte to the MCP7940 OSCTRIM register to adjust the RTC oscillator frequency. It then reads back the OSCTRIM register and compares it to the written value to confirm that the configuration was accepted by the device.
  */
-MCP7940_Error mcp7940_setweekday(unsigned char weekday)
+MCP7940_Error mcp7940_dev_trimming(MCP7940_Device *device, MCP7940_Trim mode, unsigned char value)
 {
-    if(weekday >= 7)
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Trimming);
+
+    value = (value & 0x7F);
+
+    if(mode == MCP7940_Trim_Add)
     {
-        return MCP7940_Error_Fail;
+        value |= 0x80;
     }
-    
-    unsigned char temp = mcp7940_read(MCP7940_RTCWKDAY);
-    mcp7940_write(MCP7940_RTCWKDAY, ((0xF8 & temp) | (0x07 & (weekday + 1))));
-    
-    return MCP7940_Error_None;
-}
 
-static unsigned char mcp7940_tobcd(unsigned char value)
-{
-    return ((value / 10)<<4) | (value%10);
-}
+    unsigned char temp;
+    MCP7940_Error error = mcp7940_write(device, MCP7940_OSCTRIM, value);
 
-static void mcp7940_setdata(
-    unsigned char address1,
-    unsigned char value1,
-    unsigned char address2,
-    unsigned char value2,
-    unsigned char address3,
-    unsigned char value3)
-{
-    mcp7940_write(address1, mcp7940_tobcd(value1));
-    mcp7940_write(address2, mcp7940_tobcd(value2));
-    mcp7940_write(address3, mcp7940_tobcd(value3));
+    if(error == MCP7940_Error_None)
+    {
+        error = mcp7940_read(device, MCP7940_OSCTRIM, &temp);
+    }
+
+    if(error != MCP7940_Error_None)
+    {
+        return mcp7940_trace(MCP7940_Trace_Trimming, error);
+    }
+    return mcp7940_trace(MCP7940_Trace_Trimming, (temp == value) ? MCP7940_Error_None : MCP7940_Error_Fail);
 }
 
 /**
- * @brief Sets the current time of the MCP7940 RTC from a FORMAT_Time structure.
+ * @brief Enables or disables the MCP7940 RTC oscillator or external clock input.
  *
- * @param time Pointer to a ::FORMAT_Time structure containing the time to be set. The following fields are used:
- * - @c time->hour   (expected range: 0–23)
- * - @c time->minute (expected range: 0–59)
- * - @c time->second (expected range: 0–59)
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param mode Selects the desired oscillator mode, using a value from ::MCP7940_Mode:
+ * - `MCP7940_Mode_Enable` to start the oscillator or enable the external clock.
+ * - `MCP7940_Mode_Disable` to stop the oscillator or disable the external clock.
  *
  * @return Returns one of the following error codes:
- * - `MCP7940_Error_None` if the supplied time is valid and the MCP7940 registers were updated successfully.
- * - `MCP7940_Error_Fail` if the supplied time is invalid according to validate_time() and no write is attempted.
+ * - `MCP7940_Error_None` if the register has been updated.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the read-modify-write failed on the bus.
  *
  * @details
- * This function first validates the @p time fields using validate_time(). If validation fails, it returns `MCP7940_Error_Fail` immediately. Otherwise, it writes the hour, minute, and second values to the MCP7940 RTCHOUR, RTCMIN, and RTCSEC registers using mcp7940_setdata(), then enables the RTC oscillator via mcp7940_oscillator() so that timekeeping starts or continues from the new value. The implementation assumes that conversion to the device’s register format (for example BCD) is handled inside mcp7940_setdata().
+ * Depending on the compile-time configuration, this function controls either the external oscillator input (MCP7940_USE_EXTOSC defined) by setting or clearing the EXTOSC bit in the CONTROL register, or the internal RTC oscillator by setting or clearing the ST (start oscillator) bit in the seconds register RTCSEC. The corresponding register is read first and then updated with the appropriate bit set or cleared while preserving the other bits.
  */
-MCP7940_Error mcp7940_settime(const FORMAT_Time *time)
+MCP7940_Error mcp7940_dev_oscillator(MCP7940_Device *device, MCP7940_Mode mode)
 {
-    if(validate_time(time) != RETURN_Valid)
-    {
-        return MCP7940_Error_Fail;
-    }
-    
-    mcp7940_setdata(
-        MCP7940_RTCHOUR, time->hour,
-        MCP7940_RTCMIN,  time->minute,
-        MCP7940_RTCSEC,  time->second
-    );
-    mcp7940_oscillator(MCP7940_Mode_Enable);
-    return MCP7940_Error_None;
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Oscillator);
+
+    unsigned char temp;
+
+    #ifdef MCP7940_USE_EXTOSC
+        MCP7940_Error error = mcp7940_load(device, MCP7940_CONTROL, &temp);
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Oscillator, error);
+        }
+
+        if(mode == MCP7940_Mode_Enable)
+        {
+            return mcp7940_trace(MCP7940_Trace_Oscillator, mcp7940_write(device, MCP7940_CONTROL, (MCP7940_EXTOSC_bm | temp)));
+        }
+        return mcp7940_trace(MCP7940_Trace_Oscillator, mcp7940_write(device, MCP7940_CONTROL, ((~MCP7940_EXTOSC_bm) & temp)));
+    #else
+        MCP7940_Error error = mcp7940_read(device, MCP7940_RTCSEC, &temp);
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Oscillator, error);
+        }
+
+        if(mode == MCP7940_Mode_Enable)
+        {
+            return mcp7940_trace(MCP7940_Trace_Oscillator, mcp7940_write(device, MCP7940_RTCSEC, (MCP7940_ST_bm | temp)));
+        }
+        return mcp7940_trace(MCP7940_Trace_Oscillator, mcp7940_write(device, MCP7940_RTCSEC, ((~MCP7940_ST_bm) & temp)));
+    #endif
 }
 
 /**
- * @brief Sets the current calendar date of the MCP7940 RTC from a FORMAT_Date structure.
+ * @brief Starts the MCP7940 oscillator and waits until the OSCRUN flag reports a running clock.
  *
- * @param date Pointer to a ::FORMAT_Date structure containing the date to be set. The following fields are used:
- * - @c date->day   (expected range: 1–31; only a basic range check is performed)
- * - @c date->month (expected range: 1–12)
- * - @c date->year  (expected range: 0–99, interpreted as an application-defined offset)
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param timeout Maximum start-up time in milliseconds, e.g. @c MCP7940_OSC_ENABLE_MS.
+ *
+ * @param elapsed Pointer that receives the measured start-up time in milliseconds (resolution @c MCP7940_OSC_POLL_MS, 0 if the oscillator was already running). May be 0 if the start-up time is not required.
  *
  * @return Returns one of the following error codes:
- * - `MCP7940_Error_None` if the supplied date is valid and the MCP7940 date registers were updated successfully.
- * - `MCP7940_Error_Fail` if the supplied date is invalid according to validate_date() and no write is attempted.
+ * - `MCP7940_Error_None` if OSCRUN is set.
+ * - `MCP7940_Error_Timeout` if OSCRUN was not set within @p timeout (@p elapsed holds the time waited).
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a bus transaction failed.
  *
  * @details
- * This function first validates the @p date fields using validate_date(). If validation fails, it returns `MCP7940_Error_Fail` immediately. Otherwise, it writes the day, month, and year values to the MCP7940 RTCDATE, RTCMTH, and RTCYEAR registers via mcp7940_setdata(). The implementation assumes that any required conversion to the device’s register format (for example, BCD encoding and leap-year bit handling) is performed inside mcp7940_setdata() or the lower-level I2C access functions.
+ * This function enables the oscillator with mcp7940_oscillator() and then polls the OSCRUN bit in RTCWKDAY every @c MCP7940_OSC_POLL_MS via systick_timer_wait_ms(). Instead of blocking for the worst-case start-up time of the crystal, it returns as soon as the oscillator runs, so the time is valid afterwards. The start-up time of a crystal increases when it ages or the load capacitance drifts, so logging @p elapsed over the lifetime of a device reveals slowly failing crystals.
  */
-MCP7940_Error mcp7940_setdate(const FORMAT_Date *date)
+MCP7940_Error mcp7940_dev_oscillator_start(MCP7940_Device *device, unsigned int timeout, unsigned int *elapsed)
 {
-    if(validate_date(date) != RETURN_Valid)
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Oscillator_Start);
+
+    unsigned int waited = 0;
+    unsigned char temp;
+    MCP7940_Error error = mcp7940_dev_oscillator(device, MCP7940_Mode_Enable);
+
+    while(error == MCP7940_Error_None)
     {
-        return MCP7940_Error_Fail;
-    }
-    
-    mcp7940_setdata(
-        MCP7940_RTCDATE, date->day,
-        MCP7940_RTCMTH,  date->month,
-        MCP7940_RTCYEAR, date->year
-    );
-    return MCP7940_Error_None;
-}
+        error = mcp7940_read(device, MCP7940_RTCWKDAY, &temp);
 
-/**
- * @brief Sets the current MCP7940 date and time from a FORMAT_DateTime structure.
+        if((error != MCP7940_Error_None) || (temp & MCP7940_OSCRUN_bm))
+        {
+            break;
+        }
+
+        if(waited >= timeout)
+        {
+            error = MCP7940_Error_Timeout;
+            break;
+        }
+        systick_timer_wait_ms(MCP7940_OSC_POLL_MS);
+        waited += MCP7940_OSC_POLL_MS;
+    }
+
+    if(elapsed)
+    {
+        *elapsed = waited;
+    }
+    return mcp7940_trace(MCP7940_Trace_Oscillator_Start, error);
+}
+
+/**
+ * @brief Reads and returns the current MCP7940 status flags from the weekday register.
  *
- * @param datetime Pointer to a ::FORMAT_DateTime structure containing both time and date components to be written to the MCP7940. The following subfields are used:
- * - @c datetime->time.hour, @c datetime->time.minute, @c datetime->time.second
- * - @c datetime->date.day,  @c datetime->date.month,  @c datetime->date.year
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @return A ::MCP7940_Status value containing a bitwise combination of:
+ * - `MCP7940_Status_Oscillator_Running` if the OSCRUN bit is set, indicating that the oscillator is currently running.
+ * - `MCP7940_Status_Power_Fail` if the PWRFAIL bit is set, indicating that a power-fail event has been logged and the corresponding time stamps are available.
+ * - `MCP7940_Status_Battery_Enabled` if the VBATEN bit is set, indicating that battery backup mode is enabled.
+ * 
+ * If none of these bits are set, or the register could not be read, the function returns `MCP7940_Status_None`.
+ *
+ * @details
+ * This function reads the RTCWKDAY register of the MCP7940 and masks out the OSCRUN, PWRFAIL, and VBATEN bits to construct an ::MCP7940_Status value. The resulting status can be used by higher-level code to determine whether the RTC oscillator is running, whether a power failure has occurred, and whether battery backup is configured.
+ */
+MCP7940_Status mcp7940_dev_status(MCP7940_Device *device)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Status);
+
+    unsigned char temp = 0;
+
+    mcp7940_trace(MCP7940_Trace_Status, mcp7940_read(device, MCP7940_RTCWKDAY, &temp));
+    return (temp & (MCP7940_OSCRUN_bm | MCP7940_PWRFAIL_bm | MCP7940_VBATEN_bm));
+}
+
+#if MCP7940_MFP_MODE == MCP7940_MFP_MODE_OUTPUT
+    /**
+     * @brief Controls the MCP7940 MFP pin when configured as a general-purpose output.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param output Desired output mode for the MFP pin, using a value from ::MCP7940_Mode:
+     * - `MCP7940_Mode_Enable` drives the MFP pin active by setting the OUT bit in the CONTROL register.
+     * - `MCP7940_Mode_Disable` releases the MFP pin (open-drain inactive state) by clearing the OUT bit.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the OUT bit has been updated.
+     * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the read-modify-write failed on the bus.
+     *
+     * @details
+     * This function is available only when @c MCP7940_MFP_MODE is set to @c MCP7940_MFP_MODE_OUTPUT at compile time. In this mode, the MFP pin behaves as an open-drain general-purpose output controlled by the OUT bit in the CONTROL register. The function reads the current CONTROL value, sets or clears the OUT bit according to @p output, and writes the updated value back, preserving all other control bits.
+     */
+    MCP7940_Error mcp7940_dev_mfp_output(MCP7940_Device *device, MCP7940_Mode output)
+    {   
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Mfp_Output);
+
+        unsigned char temp;
+        MCP7940_Error error = mcp7940_load(device, MCP7940_CONTROL, &temp);
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Mfp_Output, error);
+        }
+        
+        if(output)
+        {
+            return mcp7940_trace(MCP7940_Trace_Mfp_Output, mcp7940_write(device, MCP7940_CONTROL, (MCP7940_OUT_bm | temp)));
+        }
+        return mcp7940_trace(MCP7940_Trace_Mfp_Output, mcp7940_write(device, MCP7940_CONTROL, ((~MCP7940_OUT_bm) & temp)));
+    }
+#endif
+
+/**
+ * @brief Reads the weekday value from the MCP7940 for the selected timestamp register set.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param data Selects which MCP7940 register block to read the weekday from, using a value from ::MCP7940_Register:
+ * - `MCP7940_Register_Current_Time` to read the current weekday from RTCWKDAY.
+ * - `MCP7940_Register_Power_Down_Time` to read the power-down weekday from PWRDNMTH.
+ * - `MCP7940_Register_Power_Up_Time` to read the power-up weekday from PWRUPMTH.
+ *
+ * @return An unsigned 3-bit weekday value in the range 0–7, where the underlying MCP7940 encoding uses 1–7 for the day-of-week and 0 may be returned if the register contents are not yet initialized or the register could not be read.
+ *
+ * @details
+ * This function extracts the weekday field from the appropriate MCP7940 register depending on @p data. For the power-down and power-up timestamp registers, the weekday bits are located in the upper three bits of the month register (PWRDNMTH or PWRUPMTH) and are right-shifted by @c MCP7940_PWRWEEKDAY_bp after masking. For the current time, the weekday is read directly from the RTCWKDAY register and masked with 0x07 to return only the weekday bits.
+ */
+unsigned char mcp7940_dev_weekday(MCP7940_Device *device, MCP7940_Register data)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Weekday);
+
+    unsigned char temp = 0;
+
+    switch (data)
+    {
+    #ifdef MCP7940_HAS_BATTERY
+        case MCP7940_Register_Power_Down_Time:
+            mcp7940_trace(MCP7940_Trace_Weekday, mcp7940_read(device, MCP7940_PWRDNMTH, &temp));
+            return ((0xE0 & temp) >> MCP7940_PWRWEEKDAY_bp);
+        case MCP7940_Register_Power_Up_Time:
+            mcp7940_trace(MCP7940_Trace_Weekday, mcp7940_read(device, MCP7940_PWRUPMTH, &temp));
+            return ((0xE0 & temp) >> MCP7940_PWRWEEKDAY_bp);
+    #endif
+        default:
+            mcp7940_trace(MCP7940_Trace_Weekday, mcp7940_read(device, MCP7940_RTCWKDAY, &temp));
+            return (0x07 & temp);
+    }
+}
+
+#ifdef MCP7940_TICK_EN
+    #if (MCP7940_MFP_MODE != MCP7940_MFP_MODE_SQUARE_WAVE) || defined(MCP7940_SQW_CRSTRIM_EN) || (MCP7940_MFP_SQUARE_WAVE_PRESCALER != MCP7940_SQWFS_1HZ)
+        #error "MCP7940_TICK_EN requires a 1 Hz square wave on MFP (MCP7940_MFP_MODE_SQUARE_WAVE with MCP7940_SQWFS_1HZ)"
+    #endif
+
+    static MCP7940_Error mcp7940_tick_fetch(MCP7940_Device *device, unsigned char *buffer);
+#endif
+
+static MCP7940_Error mcp7940_fetch(MCP7940_Device *device, MCP7940_Register reg, unsigned char *buffer)
+{
+#ifdef MCP7940_HAS_BATTERY
+    unsigned char address;
+    MCP7940_Error error;
+#endif
+
+    switch (reg)
+    {
+    #ifdef MCP7940_HAS_BATTERY
+        case MCP7940_Register_Power_Down_Time:
+            address = MCP7940_PWRDNMIN;
+        break;
+        case MCP7940_Register_Power_Up_Time:
+            address = MCP7940_PWRUPMIN;
+        break;
+    #endif
+        default:
+            #ifdef MCP7940_TICK_EN
+                {
+                    // Only an unsynchronised clock falls back to the device, bus errors of a due resync are reported
+                    MCP7940_Error status = mcp7940_tick_fetch(device, buffer);
+
+                    if(status != MCP7940_Error_Fail)
+                    {
+                        return status;
+                    }
+                }
+            #endif
+        return mcp7940_read_burst(device, MCP7940_RTCSEC, buffer, MCP7940_RTCC_SIZE);
+    }
+
+#ifdef MCP7940_HAS_BATTERY
+    // Timestamp block is MIN, HOUR, DATE, MTH -> spread into the RTCC layout
+    error = mcp7940_read_burst(device, address, &buffer[MCP7940_RTCMIN], MCP7940_TIMESTAMP_SIZE);
+
+    if(error != MCP7940_Error_None)
+    {
+        return error;
+    }
+
+    buffer[MCP7940_RTCMTH]   = buffer[MCP7940_RTCDATE];
+    buffer[MCP7940_RTCDATE]  = buffer[MCP7940_RTCWKDAY];
+    buffer[MCP7940_RTCWKDAY] = ((0xE0 & buffer[MCP7940_RTCMTH]) >> MCP7940_PWRWEEKDAY_bp);
+    buffer[MCP7940_RTCSEC]   = 0;
+    buffer[MCP7940_RTCYEAR]  = 0;
+
+    return MCP7940_Error_None;
+#endif
+}
+
+static unsigned char mcp7940_tohour(unsigned char value)
+{
+    if(!(value & MCP7940_FORMAT_bm))
+    {
+        return mcp7940_tobinary(value, MCP7940_HRTEN_bm);
+    }
+
+    // 12-hour format: 12 AM is 0, 12 PM is 12
+    unsigned char hour = mcp7940_tobinary(value, MCP7940_HRTEN12_bm);
+    hour = (hour == 12) ? 0 : hour;
+
+    return (value & MCP7940_AMPM_bm) ? (hour + 12) : hour;
+}
+
+static void mcp7940_decode_time(const unsigned char *buffer, FORMAT_Time *time)
+{
+    time->hour   = mcp7940_tohour(buffer[MCP7940_RTCHOUR]);
+    time->minute = mcp7940_tobinary(buffer[MCP7940_RTCMIN],  MCP7940_MINTEN_bm);
+    time->second = mcp7940_tobinary(buffer[MCP7940_RTCSEC],  MCP7940_SECTEN_bm);
+}
+
+static void mcp7940_decode_date(const unsigned char *buffer, FORMAT_Date *date)
+{
+    date->day   = mcp7940_tobinary(buffer[MCP7940_RTCDATE], MCP7940_DATETEN_bm);
+    date->month = mcp7940_tobinary(buffer[MCP7940_RTCMTH],  MCP7940_MTHTEN_bm);
+    date->year  = mcp7940_tobinary(buffer[MCP7940_RTCYEAR], MCP7940_YRTEN_bm);
+}
+
+/**
+ * @brief Reads hour, minute, and second fields from the MCP7940 into a FORMAT_Time structure.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param time Pointer to a ::FORMAT_Time structure that will be populated with time information from the MCP7940 registers. On return:
+ * - @c time->hour contains the decoded hour value.
+ * - @c time->minute contains the decoded minute value.
+ * - @c time->second contains the decoded second value for current time, or 0 for power-up/power-down timestamp selections.
  *
- * @return A combined ::MCP7940_Error value obtained by OR-ing the results of:
- * - mcp7940_settime() for the time component.
- * - mcp7940_setdate() for the date component.
- * If both calls succeed, the function returns `MCP7940_Error_None`; if either fails, the resulting value will include `MCP7940_Error_Fail`.
+ * @param reg Selects which MCP7940 register set to read, using a value from ::MCP7940_Register:
+ * - `MCP7940_Register_Current_Time` to read the live time registers.
+ * - `MCP7940_Register_Power_Down_Time` to read the power-down timestamp.
+ * - `MCP7940_Register_Power_Up_Time` to read the power-up timestamp.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the registers have been read and decoded.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the read failed on the bus, in which case @p time is not modified.
+ *
+ * @details
+ * This function fetches the selected register block with a single sequential (auto-increment) read and decodes the hour, minute and second fields from the buffer into @p time. For power-down and power-up timestamp registers, @c time->second is set to 0, since those registers do not store a separate seconds value.
+ */
+MCP7940_Error mcp7940_dev_time(MCP7940_Device *device, FORMAT_Time *time, MCP7940_Register reg)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Time);
+
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+    MCP7940_Error error = mcp7940_fetch(device, reg, buffer);
+
+    if(error == MCP7940_Error_None)
+    {
+        mcp7940_decode_time(buffer, time);
+    }
+    return mcp7940_trace(MCP7940_Trace_Time, error);
+}
+
+/**
+ * @brief Reads day, month, and year fields from the MCP7940 into a FORMAT_Date structure.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param date Pointer to a ::FORMAT_Date structure that will be populated with calendar information from the MCP7940 registers. On return:
+ * - @c date->day contains the decoded day-of-month value.
+ * - @c date->month contains the decoded month value.
+ * - @c date->year contains the decoded year value for current time, or 0 for power-up/power-down timestamp selections.
+ *
+ * @param reg Selects which MCP7940 register set to read, using a value from ::MCP7940_Register:
+ * - `MCP7940_Register_Current_Time` to read the live calendar date.
+ * - `MCP7940_Register_Power_Down_Time` to read the power-down timestamp date.
+ * - `MCP7940_Register_Power_Up_Time` to read the power-up timestamp date.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the registers have been read and decoded.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the read failed on the bus, in which case @p date is not modified.
+ *
+ * @details
+ * This function fetches the selected register block with a single sequential (auto-increment) read and decodes the day, month and year fields from the buffer into @p date. For power-down and power-up timestamp registers, @c date->year is set to 0, as the device does not store a year with those timestamp records.
+ */
+MCP7940_Error mcp7940_dev_date(MCP7940_Device *device, FORMAT_Date *date, MCP7940_Register reg)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Date);
+
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+    MCP7940_Error error = mcp7940_fetch(device, reg, buffer);
+
+    if(error == MCP7940_Error_None)
+    {
+        mcp7940_decode_date(buffer, date);
+    }
+    return mcp7940_trace(MCP7940_Trace_Date, error);
+}
+
+/**
+ * @brief Reads both time and date from the MCP7940 into a FORMAT_DateTime structure.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param datetime Pointer to a ::FORMAT_DateTime structure that will be filled with the time and date fields obtained from the MCP7940 registers corresponding to @p reg. On return, @c datetime->time and @c datetime->date contain the decoded values.
+ *
+ * @param reg Selects which MCP7940 register set to read, using a value from ::MCP7940_Register:
+ * - `MCP7940_Register_Current_Time` to read the live date and time.
+ * - `MCP7940_Register_Power_Down_Time` to read the power-down timestamp.
+ * - `MCP7940_Register_Power_Up_Time` to read the power-up timestamp.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the registers have been read and decoded.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the read failed on the bus, in which case @p datetime is not modified.
+ *
+ * @details
+ * This function reads the complete register block selected by @p reg (RTCSEC to RTCYEAR for the current time, or the four timestamp registers for power-down/power-up) in one sequential I2C transaction and decodes both the time and the date portion from the same buffer. This costs a single bus transaction instead of one per field.
+ */
+MCP7940_Error mcp7940_dev_datetime(MCP7940_Device *device, FORMAT_DateTime *datetime, MCP7940_Register reg)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Datetime);
+
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+    MCP7940_Error error = mcp7940_fetch(device, reg, buffer);
+
+    if(error == MCP7940_Error_None)
+    {
+        mcp7940_decode_time(buffer, &datetime->time);
+        mcp7940_decode_date(buffer, &datetime->date);
+    }
+    return mcp7940_trace(MCP7940_Trace_Datetime, error);
+}
+
+static MCP7940_Error mcp7940_capture(MCP7940_Device *device, unsigned char *buffer, unsigned char length)
+{
+    for(unsigned char retry = 0; retry < MCP7940_ATOMIC_RETRIES; retry++)
+    {
+        unsigned char temp;
+        MCP7940_Error error = mcp7940_read_burst(device, MCP7940_RTCSEC, buffer, length);
+
+        if(error == MCP7940_Error_None)
+        {
+            error = mcp7940_read(device, MCP7940_RTCSEC, &temp);
+        }
+
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+
+        if(((~MCP7940_ST_bm) & (temp ^ buffer[MCP7940_RTCSEC])) == 0)
+        {
+            return MCP7940_Error_None;
+        }
+    }
+    return MCP7940_Error_Fail;
+}
+
+/**
+ * @brief Reads a tear-free snapshot of the current date and time from the MCP7940.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param datetime Pointer to a ::FORMAT_DateTime structure that will be filled with the current time and date. The structure is only modified when a consistent snapshot could be captured.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if a consistent snapshot was captured and decoded into @p datetime.
+ * - `MCP7940_Error_Fail` if the seconds register changed during each of the @c MCP7940_ATOMIC_RETRIES attempts.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a read failed on the bus (no further attempt is made).
+ *
+ * @details
+ * This function captures all seven timekeeping registers (RTCSEC to RTCYEAR) with one sequential read and afterwards re-reads RTCSEC. If the seconds value differs from the one in the burst, a seconds increment (and therefore possibly a carry into minutes, hours or the date) happened while the block was transferred and the burst is repeated. The returned ::FORMAT_DateTime therefore always corresponds to one single instant, even across a midnight rollover.
+ */
+MCP7940_Error mcp7940_dev_datetime_atomic(MCP7940_Device *device, FORMAT_DateTime *datetime)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Datetime_Atomic);
+
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+    MCP7940_Error error = mcp7940_capture(device, buffer, MCP7940_RTCC_SIZE);
+
+    if(error != MCP7940_Error_None)
+    {
+        return mcp7940_trace(MCP7940_Trace_Datetime_Atomic, error);
+    }
+
+    mcp7940_decode_time(buffer, &datetime->time);
+    mcp7940_decode_date(buffer, &datetime->date);
+    return mcp7940_trace(MCP7940_Trace_Datetime_Atomic, MCP7940_Error_None);
+}
+
+/**
+ * @brief Returns the current leap year status from the MCP7940 device.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @return A ::MCP7940_LeapYear value derived from the MCP7940 leap-year field:
+ * - `MCP7940_LeapYear_False` if the device indicates a non-leap year.
+ * - `MCP7940_LeapYear_True` if the device indicates a leap year.
+ *
+ * If the register could not be read, `MCP7940_LeapYear_False` is returned.
+ *
+ * @details
+ * This function reads the RTCMTH register of the MCP7940 and masks and shifts the LPYR bit into the ::MCP7940_LeapYear enumeration domain. The returned value reflects the RTC’s internal leap-year status, which influences how February 29 is handled in the device’s calendar logic. If further registers are required, mcp7940_snapshot() provides the same information together with the time and status in one read.
+ */
+MCP7940_LeapYear mcp7940_dev_leapyear(MCP7940_Device *device)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Leapyear);
+
+    unsigned char temp = 0;
+
+    mcp7940_trace(MCP7940_Trace_Leapyear, mcp7940_read(device, MCP7940_RTCMTH, &temp));
+    return ((MCP7940_LPYR_bm & temp)>>MCP7940_LPYR_bp);
+}
+
+/**
+ * @brief Reads the MCP7940 registers RTCSEC to OSCTRIM into a register snapshot.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param snapshot Pointer to a ::MCP7940_Snapshot structure that receives the raw register values.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the snapshot has been read.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the read failed on the bus, in which case the contents of @p snapshot are undefined.
+ *
+ * @details
+ * All nine registers are read in a single sequential transaction. The snapshot can then be evaluated without further bus access with mcp7940_snapshot_datetime(), the formatters mcp7940_snapshot_iso8601() and mcp7940_snapshot_weekday_string() and the inline accessors (mcp7940_snapshot_leapyear(), mcp7940_snapshot_status(), mcp7940_snapshot_running(), mcp7940_snapshot_powerfail(), mcp7940_snapshot_battery(), mcp7940_snapshot_hour12() and mcp7940_snapshot_weekday()). With @c MCP7940_SHADOW_EN the shadow copies of RTCWKDAY, CONTROL and OSCTRIM are refreshed as well.
+ */
+MCP7940_Error mcp7940_dev_snapshot(MCP7940_Device *device, MCP7940_Snapshot *snapshot)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Snapshot);
+
+    return mcp7940_trace(MCP7940_Trace_Snapshot, mcp7940_read_burst(device, MCP7940_RTCSEC, snapshot->data, sizeof(snapshot->data)));
+}
+
+/**
+ * @brief Reads a tear-free register snapshot of the MCP7940 registers RTCSEC to OSCTRIM.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param snapshot Pointer to a ::MCP7940_Snapshot structure that receives the raw register values.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if a consistent snapshot has been read.
+ * - `MCP7940_Error_Fail` if no consistent snapshot could be captured within @c MCP7940_ATOMIC_RETRIES attempts.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a read failed on the bus, in which case the contents of @p snapshot are undefined.
  *
  * @details
- * This function is a convenience wrapper that programs both the current time and calendar date of the MCP7940 in one call. It first calls mcp7940_settime() with @c datetime->time and then mcp7940_setdate() with @c datetime->date. The individual error codes are bitwise OR-combined and returned to the caller, allowing detection of failures in either step.
+ * The snapshot is read like with mcp7940_snapshot() and then validated like with mcp7940_datetime_atomic(): RTCSEC is read once more and the snapshot is repeated if the seconds changed in between. Time, date and weekday therefore belong to the same second, even across a rollover at midnight. This costs one additional read transaction compared to mcp7940_snapshot().
  */
-MCP7940_Error mcp7940_setdatetime(const FORMAT_DateTime *datetime)
+MCP7940_Error mcp7940_dev_snapshot_atomic(MCP7940_Device *device, MCP7940_Snapshot *snapshot)
 {
-    MCP7940_Error error = MCP7940_Error_None;
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Snapshot_Atomic);
 
-    error |= mcp7940_settime(&datetime->time);
-    error |= mcp7940_setdate(&datetime->date);
+    return mcp7940_trace(MCP7940_Trace_Snapshot_Atomic, mcp7940_capture(device, snapshot->data, sizeof(snapshot->data)));
+}
 
-    return error;
-}
\ No newline at end of file
+/**
+ * @brief Decodes the date and time of a register snapshot into a FORMAT_DateTime structure.
+ *
+ * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+ *
+ * @param datetime Pointer to a ::FORMAT_DateTime structure that receives the decoded date and time.
+ */
+void mcp7940_snapshot_datetime(const MCP7940_Snapshot *snapshot, FORMAT_DateTime *datetime)
+{
+    mcp7940_decode_time(snapshot->data, &datetime->time);
+    mcp7940_decode_date(snapshot->data, &datetime->date);
+}
+
+/**
+ * @brief Returns the three-letter weekday abbreviation of a register snapshot.
+ *
+ * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+ *
+ * @return Pointer to a constant, null-terminated string (see mcp7940_weekday_string()).
+ *
+ * @details
+ * The weekday is taken from the RTCWKDAY byte of the snapshot, so unlike mcp7940_weekday_string(mcp7940_weekday()) no further bus access is performed.
+ */
+const char* mcp7940_snapshot_weekday_string(const MCP7940_Snapshot *snapshot)
+{
+    return mcp7940_weekday_string(snapshot->data[MCP7940_RTCWKDAY] & 0x07);
+}
+
+static char* mcp7940_digits(char *buffer, unsigned char bcd, char separator)
+{
+    buffer[0] = (char)('0' + (bcd >> 4));
+    buffer[1] = (char)('0' + (bcd & 0x0F));
+    buffer[2] = separator;
+
+    return &buffer[3];
+}
+
+/**
+ * @brief Formats the date and time of a register snapshot as ISO 8601 string.
+ *
+ * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+ *
+ * @param buffer Caller-provided buffer of at least @c MCP7940_ISO8601_SIZE characters that receives the null-terminated string `YYYY-MM-DDThh:mm:ss` (e.g. `2026-10-14T12:30:00`).
+ *
+ * @return Pointer to @p buffer, so the call can be used directly as an argument (e.g. of a log function).
+ *
+ * @details
+ * The digits are taken straight from the BCD nibbles of the snapshot without converting the fields to binary and without any library call, bus access or dynamic memory. The year is printed as 2000 to 2099. The hour is always printed in 24-hour format, a snapshot of a device in 12-hour mode is converted with the AM/PM bit of the same byte. The snapshot is not validated, so invalid register contents (e.g. an uninitialized device) yield non-digit characters but never exceed the buffer.
+ */
+char* mcp7940_snapshot_iso8601(const MCP7940_Snapshot *snapshot, char *buffer)
+{
+    const unsigned char *data = snapshot->data;
+    unsigned char hour = mcp7940_tohour(data[MCP7940_RTCHOUR]);
+    unsigned char tens = (hour >= 20) ? 2 : ((hour >= 10) ? 1 : 0);
+
+    char *pointer = buffer;
+
+    *pointer++ = '2';
+    *pointer++ = '0';
+
+    pointer = mcp7940_digits(pointer, data[MCP7940_RTCYEAR], '-');
+    pointer = mcp7940_digits(pointer, (data[MCP7940_RTCMTH] & 0x1F), '-');
+    pointer = mcp7940_digits(pointer, (data[MCP7940_RTCDATE] & 0x3F), 'T');
+    pointer = mcp7940_digits(pointer, (unsigned char)((tens << 4) | (hour - ((tens << 3) + (tens << 1)))), ':');
+    pointer = mcp7940_digits(pointer, (data[MCP7940_RTCMIN] & 0x7F), ':');
+    mcp7940_digits(pointer, (data[MCP7940_RTCSEC] & 0x7F), '\0');
+
+    return buffer;
+}
+
+/**
+ * @brief Sets the MCP7940 weekday field in the RTCWKDAY register.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param weekday Zero-based weekday index to be written to the device. Valid values are:
+ * - 0 for the first day of the week (mapped to device value 1),
+ * - 1 for the second day of the week (mapped to device value 2),
+ * - ...
+ * - 6 for the seventh day of the week (mapped to device value 7).
+ * 
+ * Values greater than or equal to 7 are rejected.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if @p weekday is within range and the RTCWKDAY register was updated.
+ * - `MCP7940_Error_Fail` if @p weekday is out of range (>= 7) and the register is not modified.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the read-modify-write failed on the bus.
+ *
+ * @details
+ * This function programs the weekday field of the MCP7940 RTCWKDAY register. The MCP7940 encodes weekday values in the range 1–7, so the provided zero-based @p weekday is incremented by 1 and masked with 0x07 before being written. The existing upper bits of RTCWKDAY (such as VBATEN and OSCRUN) are preserved by masking with 0xF8 and OR-ing in the new weekday value. PWRFAIL is always written as 1, which leaves the flag unchanged, so a power failure latched after RTCWKDAY was cached (@c MCP7940_SHADOW_EN) is not cleared together with its timestamps.
+ */
+MCP7940_Error mcp7940_dev_setweekday(MCP7940_Device *device, unsigned char weekday)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Setweekday);
+
+    if(weekday >= 7)
+    {
+        return mcp7940_trace(MCP7940_Trace_Setweekday, MCP7940_Error_Fail);
+    }
+    
+    unsigned char temp;
+    MCP7940_Error error = mcp7940_load(device, MCP7940_RTCWKDAY, &temp);
+
+    if(error != MCP7940_Error_None)
+    {
+        return mcp7940_trace(MCP7940_Trace_Setweekday, error);
+    }
+    // PWRFAIL can only be cleared, writing 1 keeps a power failure latched since the value was cached
+    return mcp7940_trace(MCP7940_Trace_Setweekday, mcp7940_write(device, MCP7940_RTCWKDAY, ((0xF8 & temp) | MCP7940_PWRFAIL_bm | (0x07 & (weekday + 1)))));
+}
+
+static unsigned char mcp7940_tobcd(unsigned char value)
+{
+    // value / 10 as (value * 103) >> 10 (exact up to 178), which avoids the division routine on targets without a divider
+    unsigned char tens = ((value * 103U)>>10);
+    return ((tens<<4) | (value - (tens<<3) - (tens<<1)));
+}
+
+static unsigned char mcp7940_fromhour(unsigned char hour)
+{
+    #if MCP7940_HOUR_FORMAT == MCP7940_HOUR_FORMAT_12
+        if(hour >= 12)
+        {
+            return (MCP7940_FORMAT_bm | MCP7940_AMPM_bm | mcp7940_tobcd((hour == 12) ? 12 : (hour - 12)));
+        }
+        return (MCP7940_FORMAT_bm | mcp7940_tobcd(hour ? hour : 12));
+    #else
+        return mcp7940_tobcd(hour);
+    #endif
+}
+
+static void mcp7940_encode_time(const FORMAT_Time *time, unsigned char *buffer)
+{
+    buffer[MCP7940_RTCSEC]  = mcp7940_tobcd(time->second);
+    buffer[MCP7940_RTCMIN]  = mcp7940_tobcd(time->minute);
+    buffer[MCP7940_RTCHOUR] = mcp7940_fromhour(time->hour);
+
+    #ifndef MCP7940_USE_EXTOSC
+        buffer[MCP7940_RTCSEC] |= MCP7940_ST_bm;
+    #endif
+}
+
+static void mcp7940_encode_date(const FORMAT_Date *date, unsigned char *buffer)
+{
+    buffer[MCP7940_RTCDATE] = mcp7940_tobcd(date->day);
+    buffer[MCP7940_RTCMTH]  = mcp7940_tobcd(date->month);
+    buffer[MCP7940_RTCYEAR] = mcp7940_tobcd(date->year);
+}
+
+static MCP7940_Error mcp7940_setblock(MCP7940_Device *device, unsigned char *buffer, unsigned char preserve)
+{
+    unsigned char wkday = buffer[MCP7940_RTCWKDAY];
+    MCP7940_Error status = MCP7940_Error_Fail;
+
+    #ifdef MCP7940_USE_EXTOSC
+        MCP7940_Error error = mcp7940_dev_oscillator(device, MCP7940_Mode_Disable);
+    #else
+        MCP7940_Error error = mcp7940_write(device, MCP7940_RTCSEC, 0x00);
+    #endif
+
+    if(error != MCP7940_Error_None)
+    {
+        return error;
+    }
+
+    // Wait until the oscillator has stopped, the last read of the weekday register is reused for the burst
+    for(unsigned char retry = 0; retry < MCP7940_OSC_STOP_RETRIES; retry++)
+    {
+        error = mcp7940_read(device, MCP7940_RTCWKDAY, &buffer[MCP7940_RTCWKDAY]);
+
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+
+        if(!(buffer[MCP7940_RTCWKDAY] & MCP7940_OSCRUN_bm))
+        {
+            status = MCP7940_Error_None;
+            break;
+        }
+    }
+    buffer[MCP7940_RTCWKDAY] = (preserve & buffer[MCP7940_RTCWKDAY]) | ((~preserve) & wkday);
+
+    error = mcp7940_write_burst(device, MCP7940_RTCSEC, buffer, MCP7940_RTCC_SIZE);
+
+    #ifdef MCP7940_USE_EXTOSC
+        if(error == MCP7940_Error_None)
+        {
+            error = mcp7940_dev_oscillator(device, MCP7940_Mode_Enable);
+        }
+    #endif
+
+    return (error != MCP7940_Error_None) ? error : status;
+}
+
+/**
+ * @brief Sets the current time of the MCP7940 RTC from a FORMAT_Time structure.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param time Pointer to a ::FORMAT_Time structure containing the time to be set. The following fields are used:
+ * - @c time->hour   (expected range: 0–23)
+ * - @c time->minute (expected range: 0–59)
+ * - @c time->second (expected range: 0–59)
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the supplied time is valid and the MCP7940 registers were updated successfully.
+ * - `MCP7940_Error_Fail` if the supplied time is invalid according to validate_time() and no write is attempted.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the write failed on the bus.
+ *
+ * @details
+ * This function first validates the @p time fields using validate_time(). If validation fails, it returns `MCP7940_Error_Fail` immediately. Otherwise, it BCD-encodes the second, minute, and hour values and writes them to the MCP7940 RTCSEC, RTCMIN, and RTCHOUR registers in one sequential write. The ST bit is merged into the seconds byte, so timekeeping starts or continues from the new value without a separate oscillator read-modify-write (with @c MCP7940_USE_EXTOSC the external clock input is enabled via mcp7940_oscillator() afterwards).
+ */
+MCP7940_Error mcp7940_dev_settime(MCP7940_Device *device, const FORMAT_Time *time)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Settime);
+
+    if(validate_time(time) != RETURN_Valid)
+    {
+        return mcp7940_trace(MCP7940_Trace_Settime, MCP7940_Error_Fail);
+    }
+    
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+
+    mcp7940_encode_time(time, buffer);
+    MCP7940_Error error = mcp7940_write_burst(device, MCP7940_RTCSEC, &buffer[MCP7940_RTCSEC], 3);
+
+    #ifdef MCP7940_USE_EXTOSC
+        if(error == MCP7940_Error_None)
+        {
+            error = mcp7940_dev_oscillator(device, MCP7940_Mode_Enable);
+        }
+    #endif
+    return mcp7940_trace(MCP7940_Trace_Settime, error);
+}
+
+/**
+ * @brief Sets the current calendar date of the MCP7940 RTC from a FORMAT_Date structure.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param date Pointer to a ::FORMAT_Date structure containing the date to be set. The following fields are used:
+ * - @c date->day   (expected range: 1–31; only a basic range check is performed)
+ * - @c date->month (expected range: 1–12)
+ * - @c date->year  (expected range: 0–99, interpreted as an application-defined offset)
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the supplied date is valid and the MCP7940 date registers were updated successfully.
+ * - `MCP7940_Error_Fail` if the supplied date is invalid according to validate_date() and no write is attempted.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the write failed on the bus.
+ *
+ * @details
+ * This function first validates the @p date fields using validate_date(). If validation fails, it returns `MCP7940_Error_Fail` immediately. Otherwise, it BCD-encodes the day, month, and year values and writes them to the MCP7940 RTCDATE, RTCMTH, and RTCYEAR registers in one sequential write. The leap-year bit in RTCMTH is read-only and maintained by the device.
+ */
+MCP7940_Error mcp7940_dev_setdate(MCP7940_Device *device, const FORMAT_Date *date)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Setdate);
+
+    if(validate_date(date) != RETURN_Valid)
+    {
+        return mcp7940_trace(MCP7940_Trace_Setdate, MCP7940_Error_Fail);
+    }
+    
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+
+    mcp7940_encode_date(date, buffer);
+    return mcp7940_trace(MCP7940_Trace_Setdate, mcp7940_write_burst(device, MCP7940_RTCDATE, &buffer[MCP7940_RTCDATE], 3));
+}
+
+/**
+ * @brief Sets the current MCP7940 date and time from a FORMAT_DateTime structure.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param datetime Pointer to a ::FORMAT_DateTime structure containing both time and date components to be written to the MCP7940. The following subfields are used:
+ * - @c datetime->time.hour, @c datetime->time.minute, @c datetime->time.second
+ * - @c datetime->date.day,  @c datetime->date.month,  @c datetime->date.year
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the supplied date and time are valid and the MCP7940 registers were updated successfully.
+ * - `MCP7940_Error_Fail` if either component is invalid according to validate_time() or validate_date() (no write is attempted), or if the oscillator did not report a stop within @c MCP7940_OSC_STOP_RETRIES polls (the registers are written and the oscillator is restarted anyway).
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a transaction failed on the bus. The sequence is aborted at that point, so the oscillator may remain stopped until the call is repeated.
+ *
+ * @details
+ * This function follows the datasheet sequence for setting the clock: the oscillator is stopped by clearing ST (or EXTOSC with @c MCP7940_USE_EXTOSC), the OSCRUN flag is polled until it clears, and then all seven timekeeping registers RTCSEC to RTCYEAR are written in a single sequential transaction. The ST bit is merged into the seconds byte and the weekday register is written back with the value read while polling, so VBATEN and the weekday are preserved. Since the time cannot advance during the write, the programmed time is exact.
+ */
+MCP7940_Error mcp7940_dev_setdatetime(MCP7940_Device *device, const FORMAT_DateTime *datetime)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Setdatetime);
+
+    if((validate_time(&datetime->time) != RETURN_Valid) || (validate_date(&datetime->date) != RETURN_Valid))
+    {
+        return mcp7940_trace(MCP7940_Trace_Setdatetime, MCP7940_Error_Fail);
+    }
+
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+
+    mcp7940_encode_time(&datetime->time, buffer);
+    mcp7940_encode_date(&datetime->date, buffer);
+
+    return mcp7940_trace(MCP7940_Trace_Setdatetime, mcp7940_setblock(device, buffer, 0xFF));
+}
+
+static const unsigned char mcp7940_alarm_polarity[] = {
+    MCP7940_MFP_ALARM1_POLARITY,
+    MCP7940_MFP_ALARM2_POLARITY
+};
+
+static unsigned char mcp7940_alarm_base(MCP7940_Alarm alarm)
+{
+    return (alarm == MCP7940_Alarm_1) ? MCP7940_ALM1SEC : MCP7940_ALM0SEC;
+}
+
+/**
+ * @brief Programs and arms one of the MCP7940 hardware alarms.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param alarm Alarm module to program, using a value from ::MCP7940_Alarm.
+ *
+ * @param datetime Pointer to a ::FORMAT_DateTime structure with the alarm time. The seconds, minutes, hours, day and month fields are used, the year is only considered for validation since the device does not compare it.
+ *
+ * @param weekday Zero-based weekday (0 to 6, see @c MCP7940_WEEKDAY_MONDAY_gc ...) used for `MCP7940_Match_Day` and `MCP7940_Match_Full`.
+ *
+ * @param match Alarm match condition, using a value from ::MCP7940_Match.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the alarm was programmed and enabled.
+ * - `MCP7940_Error_Fail` if @p datetime or @p weekday is invalid and no write is attempted.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if writing the alarm registers or enabling the alarm failed on the bus.
+ *
+ * @details
+ * This function BCD-encodes the alarm time and writes all six alarm registers (ALMxSEC to ALMxMTH) in one sequential write. The ALMxWKDAY byte combines the configured polarity, the match condition and the weekday, and clears a pending ALMIF flag at the same time. Afterwards the corresponding ALMxEN bit is set in the CONTROL register.
+ */
+MCP7940_Error mcp7940_dev_alarm_set(MCP7940_Device *device, MCP7940_Alarm alarm, const FORMAT_DateTime *datetime, unsigned char weekday, MCP7940_Match match)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Alarm_Set);
+
+    if((weekday >= 7) || (validate_time(&datetime->time) != RETURN_Valid) || (validate_date(&datetime->date) != RETURN_Valid))
+    {
+        return mcp7940_trace(MCP7940_Trace_Alarm_Set, MCP7940_Error_Fail);
+    }
+
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+
+    mcp7940_encode_time(&datetime->time, buffer);
+    mcp7940_encode_date(&datetime->date, buffer);
+
+    buffer[MCP7940_RTCSEC]  &= ~MCP7940_ST_bm;
+    buffer[MCP7940_RTCWKDAY] = mcp7940_alarm_polarity[alarm] | match | (0x07 & (weekday + 1));
+
+    MCP7940_Error error = mcp7940_write_burst(device, mcp7940_alarm_base(alarm), buffer, (MCP7940_RTCC_SIZE - 1));
+
+    if(error != MCP7940_Error_None)
+    {
+        return mcp7940_trace(MCP7940_Trace_Alarm_Set, error);
+    }
+    device->alarm_wkday[alarm] = buffer[MCP7940_RTCWKDAY];
+
+    return mcp7940_trace(MCP7940_Trace_Alarm_Set, mcp7940_dev_alarm_enable(device, alarm, MCP7940_Mode_Enable));
+}
+
+/**
+ * @brief Reads the programmed configuration of one of the MCP7940 hardware alarms.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param alarm Alarm module to read, using a value from ::MCP7940_Alarm.
+ * @param datetime Pointer to a ::FORMAT_DateTime structure that receives the alarm time (the year is set to 0).
+ * @param weekday Pointer that receives the zero-based alarm weekday.
+ * @param match Pointer that receives the programmed match condition.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the alarm configuration has been read.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the read failed on the bus, in which case the output parameters are not modified.
+ *
+ * @details
+ * All six alarm registers are fetched with one sequential read. The alarm register block has the same layout as RTCSEC to RTCMTH, so the same decoding as for the current time is applied.
+ */
+MCP7940_Error mcp7940_dev_alarm_get(MCP7940_Device *device, MCP7940_Alarm alarm, FORMAT_DateTime *datetime, unsigned char *weekday, MCP7940_Match *match)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Alarm_Get);
+
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+    MCP7940_Error error = mcp7940_read_burst(device, mcp7940_alarm_base(alarm), buffer, (MCP7940_RTCC_SIZE - 1));
+
+    if(error != MCP7940_Error_None)
+    {
+        return mcp7940_trace(MCP7940_Trace_Alarm_Get, error);
+    }
+    buffer[MCP7940_RTCYEAR] = 0;
+
+    mcp7940_decode_time(buffer, &datetime->time);
+    mcp7940_decode_date(buffer, &datetime->date);
+
+    *weekday = (0x07 & (buffer[MCP7940_RTCWKDAY] - 1));
+    *match = (MCP7940_Match)(buffer[MCP7940_RTCWKDAY] & (MCP7940_ALARM_ALMMSK2_bm | MCP7940_ALARM_ALMMSK1_bm | MCP7940_ALARM_ALMMSK0_bm));
+
+    device->alarm_wkday[alarm] = (buffer[MCP7940_RTCWKDAY] & ~MCP7940_ALARM_ALMIF_bm);
+    return mcp7940_trace(MCP7940_Trace_Alarm_Get, MCP7940_Error_None);
+}
+
+/**
+ * @brief Enables or disables one of the MCP7940 hardware alarms.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param alarm Alarm module, using a value from ::MCP7940_Alarm.
+ * @param mode `MCP7940_Mode_Enable` sets and `MCP7940_Mode_Disable` clears the ALMxEN bit in the CONTROL register.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the CONTROL register has been updated.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the read-modify-write failed on the bus.
+ *
+ * @details
+ * The alarm registers are not modified, so a disabled alarm can be re-enabled with its previous configuration.
+ */
+MCP7940_Error mcp7940_dev_alarm_enable(MCP7940_Device *device, MCP7940_Alarm alarm, MCP7940_Mode mode)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Alarm_Enable);
+
+    unsigned char mask = (alarm == MCP7940_Alarm_1) ? MCP7940_ALM1EN_bm : MCP7940_ALM0EN_bm;
+    unsigned char temp;
+    MCP7940_Error error = mcp7940_load(device, MCP7940_CONTROL, &temp);
+
+    if(error != MCP7940_Error_None)
+    {
+        return mcp7940_trace(MCP7940_Trace_Alarm_Enable, error);
+    }
+
+    if(mode == MCP7940_Mode_Enable)
+    {
+        return mcp7940_trace(MCP7940_Trace_Alarm_Enable, mcp7940_write(device, MCP7940_CONTROL, (mask | temp)));
+    }
+    return mcp7940_trace(MCP7940_Trace_Alarm_Enable, mcp7940_write(device, MCP7940_CONTROL, ((~mask) & temp)));
+}
+
+/**
+ * @brief Clears the interrupt flag (ALMIF) of one of the MCP7940 hardware alarms.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param alarm Alarm module, using a value from ::MCP7940_Alarm.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the flag has been cleared.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a transaction failed on the bus.
+ *
+ * @details
+ * Clearing ALMIF releases the MFP pin and re-arms the alarm for its next match. If the alarm was programmed or read by this driver before, the ALMxWKDAY value is known and the flag is cleared with a single register write, otherwise the register is read first to preserve polarity, match condition and weekday.
+ */
+MCP7940_Error mcp7940_dev_alarm_clear(MCP7940_Device *device, MCP7940_Alarm alarm)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Alarm_Clear);
+
+    unsigned char address = (mcp7940_alarm_base(alarm) + MCP7940_RTCWKDAY);
+
+    if(!device->alarm_wkday[alarm])
+    {
+        unsigned char temp;
+        MCP7940_Error error = mcp7940_read(device, address, &temp);
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Alarm_Clear, error);
+        }
+        device->alarm_wkday[alarm] = (temp & ~MCP7940_ALARM_ALMIF_bm);
+    }
+    return mcp7940_trace(MCP7940_Trace_Alarm_Clear, mcp7940_write(device, address, device->alarm_wkday[alarm]));
+}
+
+/**
+ * @brief Checks whether one of the MCP7940 hardware alarms has triggered.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param alarm Alarm module, using a value from ::MCP7940_Alarm.
+ *
+ * @return Non-zero if the ALMIF flag of the selected alarm is set, otherwise 0 (also if the register could not be read).
+ *
+ * @details
+ * Only the ALMxWKDAY register of the selected alarm is read. The flag stays set until it is cleared with mcp7940_alarm_clear() or the alarm is reprogrammed.
+ */
+unsigned char mcp7940_dev_alarm_pending(MCP7940_Device *device, MCP7940_Alarm alarm)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Alarm_Pending);
+
+    unsigned char temp = 0;
+
+    mcp7940_trace(MCP7940_Trace_Alarm_Pending, mcp7940_read(device, (mcp7940_alarm_base(alarm) + MCP7940_RTCWKDAY), &temp));
+    return (temp & MCP7940_ALARM_ALMIF_bm);
+}
+
+static MCP7940_Error mcp7940_sram_range(unsigned char offset, unsigned char length)
+{
+    if((offset >= MCP7940_SRAM_SIZE) || (length > (MCP7940_SRAM_SIZE - offset)))
+    {
+        return MCP7940_Error_Fail;
+    }
+    return MCP7940_Error_None;
+}
+
+/**
+ * @brief Reads a block of bytes from the MCP7940 battery-backed SRAM.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param offset Byte offset inside the SRAM block (0 to @c MCP7940_SRAM_SIZE - 1), relative to @c MCP7940_SRAM.
+ * @param data Pointer to a buffer with at least @p length bytes that receives the SRAM content.
+ * @param length Number of bytes to read.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the block was read (or @p length is 0).
+ * - `MCP7940_Error_Fail` if @p offset or @p offset + @p length exceeds the SRAM block; no bus access is made in this case.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the transfer failed on the bus.
+ *
+ * @details
+ * The complete block is transferred with one sequential (auto-increment) read, so a full 64-byte checkpoint costs a single I2C transaction. Requests that would wrap around the end of the SRAM are rejected instead of silently continuing at the start of the block.
+ */
+MCP7940_Error mcp7940_dev_sram_read(MCP7940_Device *device, unsigned char offset, unsigned char *data, unsigned char length)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Sram_Read);
+
+    if(mcp7940_sram_range(offset, length) != MCP7940_Error_None)
+    {
+        return mcp7940_trace(MCP7940_Trace_Sram_Read, MCP7940_Error_Fail);
+    }
+
+    if(length)
+    {
+        return mcp7940_trace(MCP7940_Trace_Sram_Read, mcp7940_read_burst(device, (MCP7940_SRAM + offset), data, length));
+    }
+    return mcp7940_trace(MCP7940_Trace_Sram_Read, MCP7940_Error_None);
+}
+
+/**
+ * @brief Writes a block of bytes to the MCP7940 battery-backed SRAM.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param offset Byte offset inside the SRAM block (0 to @c MCP7940_SRAM_SIZE - 1), relative to @c MCP7940_SRAM.
+ * @param data Pointer to the @p length bytes that should be stored.
+ * @param length Number of bytes to write.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the block was written (or @p length is 0).
+ * - `MCP7940_Error_Fail` if @p offset or @p offset + @p length exceeds the SRAM block; no bus access is made in this case.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the transfer failed on the bus.
+ *
+ * @details
+ * The complete block is transferred with one sequential (auto-increment) write. Since the SRAM has no write cycle time and no wear, it is well suited for counters or checkpoint data that change frequently and must survive a main power loss while VBAT is present.
+ */
+MCP7940_Error mcp7940_dev_sram_write(MCP7940_Device *device, unsigned char offset, const unsigned char *data, unsigned char length)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Sram_Write);
+
+    if(mcp7940_sram_range(offset, length) != MCP7940_Error_None)
+    {
+        return mcp7940_trace(MCP7940_Trace_Sram_Write, MCP7940_Error_Fail);
+    }
+
+    if(length)
+    {
+        return mcp7940_trace(MCP7940_Trace_Sram_Write, mcp7940_write_burst(device, (MCP7940_SRAM + offset), data, length));
+    }
+    return mcp7940_trace(MCP7940_Trace_Sram_Write, MCP7940_Error_None);
+}
+
+#ifdef MCP7940_HAS_EEPROM
+    static MCP7940_Error mcp7940_eeprom_select(MCP7940_Device *device, unsigned char address)
+    {
+        #ifndef MCP7940_MULTI_DEVICE
+            (void)device;
+        #endif
+
+        #ifdef MCP7940_ASYNC_EN
+            if(mcp7940_async_busy())
+            {
+                return MCP7940_Error_Fail;
+            }
+        #endif
+
+        // Acknowledge polling: the EEPROM does not answer while a write cycle is in progress
+        for(unsigned int poll = 0; poll < MCP7940_EEPROM_POLLS; poll++)
+        {
+            MCP7940_Error error = MCP7940_BUS_START(device);
+
+            if(error == MCP7940_Error_None)
+            {
+                error = MCP7940_BUS_SLAVE(device, MCP7940_EEPROM_ADDRESS, TWI_WRITE);
+
+                if(error == MCP7940_Error_None)
+                {
+                    error = MCP7940_BUS_SET(device, address);
+
+                    if(error == MCP7940_Error_None)
+                    {
+                        return MCP7940_Error_None;
+                    }
+                }
+            }
+            MCP7940_BUS_STOP(device);
+
+            // Only a missing acknowledge of the slave address means busy, everything else fails fast
+            if(error != MCP7940_Error_Nack)
+            {
+                return error;
+            }
+        }
+        return MCP7940_Error_Timeout;
+    }
+
+    static MCP7940_Error mcp7940_eeprom_fetch(MCP7940_Device *device, unsigned char address, unsigned char *data, unsigned char length)
+    {
+        MCP7940_Error error = mcp7940_eeprom_select(device, address);
+
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+        error = MCP7940_BUS_SLAVE(device, MCP7940_EEPROM_ADDRESS, TWI_READ);
+
+        while(length-- && (error == MCP7940_Error_None))
+        {
+            error = MCP7940_BUS_GET(device, data++, (length ? TWI_ACK : TWI_NACK));
+        }
+        MCP7940_BUS_STOP(device);
+
+        return error;
+    }
+
+    /**
+     * @brief Reads a block of bytes from the EEPROM of the MCP7941x.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param address EEPROM address of the first byte (0 to @c MCP7940_EEPROM_SIZE - 1).
+     *
+     * @param data Pointer to a buffer that receives @p length bytes.
+     *
+     * @param length Number of bytes to read.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the block was read.
+     * - `MCP7940_Error_Fail` if @p length is 0 or the block exceeds the EEPROM.
+     * - `MCP7940_Error_Timeout` if the EEPROM did not acknowledge within @c MCP7940_EEPROM_POLLS polls.
+     * - `MCP7940_Error_Nack` or `MCP7940_Error_Arbitration` if the transfer failed on the bus.
+     *
+     * @details
+     * This function is available only for variants with EEPROM (@c MCP7940_HAS_EEPROM). The whole block is read in one sequential transaction from @c MCP7940_EEPROM_ADDRESS. If a write cycle is still in progress, the access is delayed by acknowledge polling instead of a fixed wait.
+     */
+    MCP7940_Error mcp7940_dev_eeprom_read(MCP7940_Device *device, unsigned char address, unsigned char *data, unsigned char length)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Eeprom_Read);
+
+        if(!length || (address >= MCP7940_EEPROM_SIZE) || (length > (MCP7940_EEPROM_SIZE - address)))
+        {
+            return mcp7940_trace(MCP7940_Trace_Eeprom_Read, MCP7940_Error_Fail);
+        }
+        return mcp7940_trace(MCP7940_Trace_Eeprom_Read, mcp7940_eeprom_fetch(device, address, data, length));
+    }
+
+    /**
+     * @brief Writes a block of bytes to the EEPROM of the MCP7941x.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param address EEPROM address of the first byte (0 to @c MCP7940_EEPROM_SIZE - 1).
+     *
+     * @param data Pointer to the @p length bytes to write.
+     *
+     * @param length Number of bytes to write.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if all pages were written.
+     * - `MCP7940_Error_Fail` if @p length is 0 or the block exceeds the EEPROM.
+     * - `MCP7940_Error_Timeout` if the EEPROM did not acknowledge within @c MCP7940_EEPROM_POLLS polls (the pages before are written).
+     * - `MCP7940_Error_Nack` or `MCP7940_Error_Arbitration` if a page transfer failed on the bus (the pages before are written).
+     *
+     * @details
+     * This function is available only for variants with EEPROM (@c MCP7940_HAS_EEPROM). The block is split at the boundaries of the @c MCP7940_EEPROM_PAGE byte pages and every page is written in one transaction, so a 128-byte image costs 16 write cycles instead of 128. Before each page the EEPROM is polled until it acknowledges, which ends the previous write cycle as early as possible. The function returns right after the last page was sent, its write cycle is awaited by the next EEPROM access.
+     */
+    MCP7940_Error mcp7940_dev_eeprom_write(MCP7940_Device *device, unsigned char address, const unsigned char *data, unsigned char length)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Eeprom_Write);
+
+        if(!length || (address >= MCP7940_EEPROM_SIZE) || (length > (MCP7940_EEPROM_SIZE - address)))
+        {
+            return mcp7940_trace(MCP7940_Trace_Eeprom_Write, MCP7940_Error_Fail);
+        }
+
+        while(length)
+        {
+            unsigned char size = (MCP7940_EEPROM_PAGE - (address & (MCP7940_EEPROM_PAGE - 1)));
+
+            if(size > length)
+            {
+                size = length;
+            }
+
+            MCP7940_Error error = mcp7940_eeprom_select(device, address);
+
+            if(error != MCP7940_Error_None)
+            {
+                return mcp7940_trace(MCP7940_Trace_Eeprom_Write, error);
+            }
+
+            for(unsigned char i = 0; (i < size) && (error == MCP7940_Error_None); i++)
+            {
+                error = MCP7940_BUS_SET(device, *data++);
+            }
+            MCP7940_BUS_STOP(device);
+
+            if(error != MCP7940_Error_None)
+            {
+                return mcp7940_trace(MCP7940_Trace_Eeprom_Write, error);
+            }
+
+            address += size;
+            length  -= size;
+        }
+        return mcp7940_trace(MCP7940_Trace_Eeprom_Write, MCP7940_Error_None);
+    }
+#endif
+
+#ifdef MCP7940_HAS_EUI
+    /**
+     * @brief Reads the pre-programmed EUI of the MCP79411 (EUI-48) or MCP79412 (EUI-64).
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param eui Pointer to a buffer of @c MCP7940_HAS_EUI bytes that receives the EUI, most significant byte first.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the EUI was read.
+     * - `MCP7940_Error_Timeout` if the EEPROM did not acknowledge within @c MCP7940_EEPROM_POLLS polls.
+     * - `MCP7940_Error_Nack` or `MCP7940_Error_Arbitration` if the transfer failed on the bus.
+     *
+     * @details
+     * This function is available only for variants with a pre-programmed EUI (@c MCP7940_HAS_EUI). The EUI is read in one sequential transaction from the end of the protected unique ID area at @c MCP7940_EUI, which does not require the unlock sequence.
+     */
+    MCP7940_Error mcp7940_dev_eui_read(MCP7940_Device *device, unsigned char *eui)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Eui_Read);
+
+        return mcp7940_trace(MCP7940_Trace_Eui_Read, mcp7940_eeprom_fetch(device, (MCP7940_EUI + (MCP7940_EUI_AREA - MCP7940_HAS_EUI)), eui, MCP7940_HAS_EUI));
+    }
+#endif
+
+#ifdef MCP7940_RECORD_EN
+    /**
+     * @brief Commits a record to the double-buffered SRAM record store.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param data Pointer to @c MCP7940_RECORD_SIZE payload bytes that should be stored.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the record was written to the SRAM.
+     * - `MCP7940_Error_Fail` if the SRAM access was rejected.
+     * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the write failed on the bus; the current record is kept in this case.
+     *
+     * @details
+     * This function is available only when @c MCP7940_RECORD_EN is defined. It increments the sequence number, appends a CRC-8 over sequence number and payload, and writes the complete slot with one sequential write into the slot that does not hold the current record. If the write is interrupted, the previous record remains valid and is selected by the recovery in mcp7940_init(). The payload is additionally kept in RAM, so mcp7940_record_restore() does not require a bus access.
+     */
+    MCP7940_Error mcp7940_dev_record_commit(MCP7940_Device *device, const unsigned char *data)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Record_Commit);
+
+        unsigned char buffer[MCP7940_RECORD_SLOT];
+        unsigned char slot = (device->record_slot == MCP7940_RECORD_NONE) ? 0 : (device->record_slot ^ 0x01);
+
+        buffer[0] = (device->record_sequence + 1);
+
+        for(unsigned char i = 0; i < MCP7940_RECORD_SIZE; i++)
+        {
+            buffer[i + 1] = data[i];
+        }
+        buffer[MCP7940_RECORD_SIZE + 1] = mcp7940_crc8(buffer, (MCP7940_RECORD_SIZE + 1));
+
+        MCP7940_Error error = mcp7940_dev_sram_write(device, (MCP7940_RECORD_OFFSET + (slot * MCP7940_RECORD_SLOT)), buffer, MCP7940_RECORD_SLOT);
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Record_Commit, error);
+        }
+
+        device->record_slot = slot;
+        device->record_sequence = buffer[0];
+
+        for(unsigned char i = 0; i < MCP7940_RECORD_SIZE; i++)
+        {
+            device->record_data[i] = data[i];
+        }
+        return mcp7940_trace(MCP7940_Trace_Record_Commit, MCP7940_Error_None);
+    }
+
+    /**
+     * @brief Returns the newest valid record of the SRAM record store.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param data Pointer to a buffer with at least @c MCP7940_RECORD_SIZE bytes that receives the record payload.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if a valid record exists and was copied to @p data.
+     * - `MCP7940_Error_Fail` if neither slot contained a valid record at mcp7940_init() and no record has been committed since.
+     *
+     * @details
+     * This function is available only when @c MCP7940_RECORD_EN is defined. The record is served from the RAM copy that was recovered by mcp7940_init() or stored by the last mcp7940_record_commit(), so no bus access is made.
+     */
+    MCP7940_Error mcp7940_dev_record_restore(MCP7940_Device *device, unsigned char *data)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Record_Restore);
+
+        if(device->record_slot == MCP7940_RECORD_NONE)
+        {
+            return mcp7940_trace(MCP7940_Trace_Record_Restore, MCP7940_Error_Fail);
+        }
+
+        for(unsigned char i = 0; i < MCP7940_RECORD_SIZE; i++)
+        {
+            data[i] = device->record_data[i];
+        }
+        return mcp7940_trace(MCP7940_Trace_Record_Restore, MCP7940_Error_None);
+    }
+#endif
+
+static const unsigned int mcp7940_cumulative_days[] = {
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365
+};
+
+static unsigned int mcp7940_days(unsigned char month, unsigned char leap)
+{
+    return mcp7940_cumulative_days[month] + ((leap && (month >= 2)) ? 1 : 0);
+}
+
+static MCP7940_Error mcp7940_toepoch(const unsigned char *buffer, unsigned long *epoch)
+{
+    unsigned char year  = mcp7940_tobinary(buffer[MCP7940_RTCYEAR], MCP7940_YRTEN_bm);
+    unsigned char month = mcp7940_tobinary(buffer[MCP7940_RTCMTH],  MCP7940_MTHTEN_bm);
+    unsigned char day   = mcp7940_tobinary(buffer[MCP7940_RTCDATE], MCP7940_DATETEN_bm);
+
+    if((month < 1) || (month > 12) || (day < 1))
+    {
+        return MCP7940_Error_Fail;
+    }
+
+    // Leap years between 2000 and the current year plus the device leap-year flag for the current year
+    unsigned int days = (year * 365U) + ((year + 3U) >> 2) + mcp7940_days((month - 1), (buffer[MCP7940_RTCMTH] & MCP7940_LPYR_bm)) + (day - 1);
+
+    *epoch = MCP7940_EPOCH_OFFSET
+           + (days * 86400UL)
+           + (mcp7940_tohour(buffer[MCP7940_RTCHOUR]) * 3600UL)
+           + (mcp7940_tobinary(buffer[MCP7940_RTCMIN],  MCP7940_MINTEN_bm) * 60U)
+           +  mcp7940_tobinary(buffer[MCP7940_RTCSEC],  MCP7940_SECTEN_bm);
+
+    return MCP7940_Error_None;
+}
+
+static void mcp7940_fromepoch(unsigned long epoch, unsigned char *buffer)
+{
+    epoch -= MCP7940_EPOCH_OFFSET;
+
+    unsigned int days   = (epoch / 86400UL);
+    unsigned long temp  = (epoch % 86400UL);
+
+    FORMAT_Time time = {
+        (temp / 3600U),
+        ((temp % 3600U) / 60U),
+        (temp % 60U)
+    };
+    mcp7940_encode_time(&time, buffer);
+
+    // 01.01.2000 was a saturday (MCP7940_WEEKDAY_SATURDAY_gc)
+    buffer[MCP7940_RTCWKDAY] = ((days + MCP7940_WEEKDAY_SATURDAY_gc) % 7) + 1;
+
+    // Every 4-year cycle starts with a leap year within 2000 to 2099
+    unsigned char year = ((days / 1461U) << 2);
+    unsigned int doy   = (days % 1461U);
+    unsigned char leap = 1;
+
+    if(doy >= 366)
+    {
+        doy -= 366;
+        year += 1 + (doy / 365);
+        doy %= 365;
+        leap = 0;
+    }
+
+    // Each month has at most 32 days, so the estimate is off by one month at most
+    unsigned char month = (doy >> 5);
+
+    if(doy >= mcp7940_days((month + 1), leap))
+    {
+        month++;
+    }
+
+    FORMAT_Date date = {
+        (doy - mcp7940_days(month, leap) + 1),
+        (month + 1),
+        year
+    };
+    mcp7940_encode_date(&date, buffer);
+}
+
+/**
+ * @brief Reads the current MCP7940 date and time as seconds since the Unix epoch.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param epoch Pointer that receives the number of seconds since 01.01.1970 00:00:00. The RTC year register is interpreted as 2000 to 2099.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if a consistent snapshot was captured and converted.
+ * - `MCP7940_Error_Fail` if no tear-free snapshot could be captured or the RTC holds an invalid date.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a read failed on the bus.
+ *
+ * @details
+ * The timekeeping registers are captured as with mcp7940_datetime_atomic() and converted directly from the BCD burst buffer. The day count is computed in constant time from the year (365 days per year plus one per elapsed leap year), a compile-time table of cumulative month lengths, and the leap-year flag (LPYR) the device reports in RTCMTH for the current year, so no loop over years or months is required.
+ */
+MCP7940_Error mcp7940_dev_epoch(MCP7940_Device *device, unsigned long *epoch)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Epoch);
+
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+    MCP7940_Error error = mcp7940_capture(device, buffer, MCP7940_RTCC_SIZE);
+
+    if(error != MCP7940_Error_None)
+    {
+        return mcp7940_trace(MCP7940_Trace_Epoch, error);
+    }
+    return mcp7940_trace(MCP7940_Trace_Epoch, mcp7940_toepoch(buffer, epoch));
+}
+
+/**
+ * @brief Sets the MCP7940 date, time and weekday from seconds since the Unix epoch.
+ *
+ * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+ *
+ * @param epoch Number of seconds since 01.01.1970 00:00:00. Valid values range from 01.01.2000 00:00:00 (@c MCP7940_EPOCH_OFFSET) to 31.12.2099 23:59:59.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the registers were updated successfully.
+ * - `MCP7940_Error_Fail` if @p epoch is outside the supported range (no write is attempted), or if the oscillator did not report a stop in time (the registers are written anyway).
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a transaction failed on the bus (see mcp7940_setdatetime()).
+ *
+ * @details
+ * The epoch is converted in constant time: the 4-year leap cycle yields the year, and the day of the year is mapped to the month with one estimate (day / 32) and a single correction against the cumulative month table. The weekday is derived from the day count with Monday as @c MCP7940_WEEKDAY_MONDAY_gc. All seven timekeeping registers are then written with the same stop/poll/burst sequence as mcp7940_setdatetime(), so the programmed time is exact and VBATEN is preserved.
+ */
+MCP7940_Error mcp7940_dev_setepoch(MCP7940_Device *device, unsigned long epoch)
+{
+    MCP7940_TRACE_BEGIN(MCP7940_Trace_Setepoch);
+
+    if((epoch < MCP7940_EPOCH_OFFSET) || (epoch >= MCP7940_EPOCH_LIMIT))
+    {
+        return mcp7940_trace(MCP7940_Trace_Setepoch, MCP7940_Error_Fail);
+    }
+
+    unsigned char buffer[MCP7940_RTCC_SIZE];
+
+    mcp7940_fromepoch(epoch, buffer);
+    return mcp7940_trace(MCP7940_Trace_Setepoch, mcp7940_setblock(device, buffer, 0xF8));
+}
+
+#ifdef MCP7940_HAS_BATTERY
+    static unsigned long mcp7940_powerfail_key(const unsigned char *buffer)
+    {
+        // BCD fields compare in the same order as their binary values, the hour is decoded because of the 12-hour format
+        return (((unsigned long)(buffer[MCP7940_RTCMTH] & 0x1F) << 24) | ((unsigned long)(buffer[MCP7940_RTCDATE] & 0x3F) << 16) | ((unsigned int)mcp7940_tohour(buffer[MCP7940_RTCHOUR]) << 8) | (buffer[MCP7940_RTCMIN] & 0x7F));
+    }
+
+    static void mcp7940_powerfail_stamp(const unsigned char *stamp, const unsigned char *reference, unsigned char *buffer)
+    {
+        // Timestamp block is MIN, HOUR, DATE, MTH -> RTCC layout
+        buffer[MCP7940_RTCSEC]   = 0;
+        buffer[MCP7940_RTCMIN]   = stamp[0];
+        buffer[MCP7940_RTCHOUR]  = stamp[1];
+        buffer[MCP7940_RTCWKDAY] = ((0xE0 & stamp[3]) >> MCP7940_PWRWEEKDAY_bp);
+        buffer[MCP7940_RTCDATE]  = stamp[2];
+        buffer[MCP7940_RTCMTH]   = (0x1F & stamp[3]);
+
+        // The stamp lies in the year of the reference or, if it is later in the year, in the year before (a 29th of february in the last leap year)
+        unsigned char year = mcp7940_tobinary(reference[MCP7940_RTCYEAR], MCP7940_YRTEN_bm);
+
+        if(mcp7940_powerfail_key(buffer) > mcp7940_powerfail_key(reference))
+        {
+            year = year ? (year - 1) : 99;
+        }
+
+        while((buffer[MCP7940_RTCMTH] == 0x02) && (buffer[MCP7940_RTCDATE] == 0x29) && (year & 0x03))
+        {
+            year--;
+        }
+
+        buffer[MCP7940_RTCYEAR] = mcp7940_tobcd(year);
+
+        if(!(year & 0x03))
+        {
+            buffer[MCP7940_RTCMTH] |= MCP7940_LPYR_bm;
+        }
+    }
+
+    /**
+     * @brief Reads the MCP7940 power-fail timestamps with the outage duration and re-arms the timestamp capture.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param powerfail Pointer to a ::MCP7940_PowerFail structure that receives the power-down and power-up time and the duration of the outage.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if a power failure has been recorded (PWRFAIL set), @p powerfail is filled and PWRFAIL has been cleared.
+     * - `MCP7940_Error_Fail` if no power failure has been recorded (@p powerfail is not modified), or the timestamps are invalid (PWRFAIL is cleared anyway).
+     * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a transaction failed on the bus; PWRFAIL is only cleared after the timestamps have been read.
+     *
+     * @details
+     * The current time, the PWRFAIL flag and both timestamps are read in a single sequential transaction from RTCSEC to PWRUPMTH, so the boot path can decide with one read whether data has to be replayed. Only if a power failure has been recorded, a second transaction clears PWRFAIL, which also clears the timestamps and re-arms the capture for the next event.
+     *
+     * Since the timestamps contain no year, the power-up year is inferred from the current date (the year before if the stamp is later in the year than now) and the power-down year from the power-up time in the same way. The duration is therefore correct for outages shorter than one year and has a resolution of one minute.
+     */
+    MCP7940_Error mcp7940_dev_powerfail_read(MCP7940_Device *device, MCP7940_PowerFail *powerfail)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Powerfail_Read);
+
+        unsigned char buffer[MCP7940_PWRUPMTH + 1];
+        MCP7940_Error error = mcp7940_read_burst(device, MCP7940_RTCSEC, buffer, sizeof(buffer));
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Powerfail_Read, error);
+        }
+
+        if(!(buffer[MCP7940_RTCWKDAY] & MCP7940_PWRFAIL_bm))
+        {
+            return mcp7940_trace(MCP7940_Trace_Powerfail_Read, MCP7940_Error_Fail);
+        }
+        error = mcp7940_write(device, MCP7940_RTCWKDAY, ((~MCP7940_PWRFAIL_bm) & buffer[MCP7940_RTCWKDAY]));
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Powerfail_Read, error);
+        }
+
+        unsigned char up[MCP7940_RTCC_SIZE];
+        unsigned char down[MCP7940_RTCC_SIZE];
+        unsigned long start;
+        unsigned long end;
+
+        mcp7940_powerfail_stamp(&buffer[MCP7940_PWRUPMIN], buffer, up);
+        mcp7940_powerfail_stamp(&buffer[MCP7940_PWRDNMIN], up, down);
+
+        if((mcp7940_toepoch(down, &start) != MCP7940_Error_None) || (mcp7940_toepoch(up, &end) != MCP7940_Error_None))
+        {
+            return mcp7940_trace(MCP7940_Trace_Powerfail_Read, MCP7940_Error_Fail);
+        }
+
+        mcp7940_decode_time(down, &powerfail->down.time);
+        mcp7940_decode_date(down, &powerfail->down.date);
+        mcp7940_decode_time(up, &powerfail->up.time);
+        mcp7940_decode_date(up, &powerfail->up.date);
+        powerfail->duration = (end - start);
+
+        return mcp7940_trace(MCP7940_Trace_Powerfail_Read, MCP7940_Error_None);
+    }
+#endif
+
+#ifdef MCP7940_CALIBRATION_EN
+    #if (MCP7940_CALIBRATION_OFFSET + 3) > MCP7940_SRAM_SIZE
+        #error "MCP7940 calibration does not fit into the SRAM (check MCP7940_CALIBRATION_OFFSET)"
+    #endif
+
+    #if defined(MCP7940_RECORD_EN) && ((MCP7940_CALIBRATION_OFFSET + 3) > MCP7940_RECORD_OFFSET) && (MCP7940_CALIBRATION_OFFSET < (MCP7940_RECORD_OFFSET + (2 * MCP7940_RECORD_SLOT)))
+        #error "MCP7940 calibration overlaps the record store (check MCP7940_CALIBRATION_OFFSET/MCP7940_RECORD_SIZE)"
+    #endif
+
+    static long mcp7940_calibration_divide(long value, long divisor)
+    {
+        return (value < 0) ? -((-value + (divisor / 2)) / divisor) : ((value + (divisor / 2)) / divisor);
+    }
+
+    static MCP7940_Error mcp7940_calibration_edge(MCP7940_Device *device, MCP7940_Reference reference, unsigned long *epoch, unsigned long *time)
+    {
+        unsigned char second;
+        unsigned char temp;
+        MCP7940_Error error = mcp7940_read(device, MCP7940_RTCSEC, &second);
+
+        for(unsigned int poll = 0; (poll < MCP7940_CALIBRATION_POLLS) && (error == MCP7940_Error_None); poll++)
+        {
+            error = mcp7940_read(device, MCP7940_RTCSEC, &temp);
+
+            if((error == MCP7940_Error_None) && (temp != second))
+            {
+                *time = reference();
+                return mcp7940_dev_epoch(device, epoch);
+            }
+        }
+        return (error != MCP7940_Error_None) ? error : MCP7940_Error_Fail;
+    }
+
+    static MCP7940_Error mcp7940_calibration_apply(MCP7940_Device *device, long steps)
+    {
+        unsigned char control;
+        MCP7940_Error error = mcp7940_load(device, MCP7940_CONTROL, &control);
+
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+
+        #if defined(MCP7940_SQW_CRSTRIM_EN)
+            steps = mcp7940_calibration_divide(steps, MCP7940_CALIBRATION_COARSE);
+        #else
+            control &= ~MCP7940_CSTRIM_bm;
+
+            #if MCP7940_MFP_MODE != MCP7940_MFP_MODE_SQUARE_WAVE
+                // Coarse trimming forces a 64 Hz square wave and is therefore only used if the fine range is exceeded by at least half a coarse step
+                if((steps >= (MCP7940_CALIBRATION_COARSE / 2)) || (steps <= -(MCP7940_CALIBRATION_COARSE / 2)))
+                {
+                    control |= MCP7940_CSTRIM_bm;
+                    steps = mcp7940_calibration_divide(steps, MCP7940_CALIBRATION_COARSE);
+                }
+            #endif
+        #endif
+
+        unsigned char buffer[3];
+
+        if(steps < 0)
+        {
+            buffer[0] = (steps < -127) ? 127 : (unsigned char)(-steps);
+        }
+        else
+        {
+            buffer[0] = (0x80 | ((steps > 127) ? 127 : (unsigned char)steps));
+        }
+        buffer[1] = (control & MCP7940_CSTRIM_bm);
+        buffer[2] = mcp7940_crc8(buffer, 2);
+
+        #ifndef MCP7940_SQW_CRSTRIM_EN
+            error = mcp7940_write(device, MCP7940_CONTROL, control);
+        #endif
+
+        if(error == MCP7940_Error_None)
+        {
+            error = mcp7940_dev_trimming(device, ((buffer[0] & 0x80) ? MCP7940_Trim_Add : MCP7940_Trim_Substract), buffer[0]);
+        }
+
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+        return mcp7940_dev_sram_write(device, MCP7940_CALIBRATION_OFFSET, buffer, sizeof(buffer));
+    }
+
+    /**
+     * @brief Opens a drift measurement window against a reference clock.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param reference Function that returns the reference time in milliseconds (see ::MCP7940_Reference).
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the start of the window has been recorded.
+     * - `MCP7940_Error_Fail` if no seconds edge was detected within @c MCP7940_CALIBRATION_POLLS reads of RTCSEC, or the time could not be read.
+     * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a read failed on the bus; the polling is aborted at the first failure.
+     *
+     * @details
+     * This function is available only when @c MCP7940_CALIBRATION_EN is defined. It polls RTCSEC until the seconds change, calls @p reference immediately at that edge and stores the reference time together with the Unix time of the RTC in the handle, so the measurement is aligned to the RTC seconds edge. The window is closed with mcp7940_calibration_end().
+     */
+    MCP7940_Error mcp7940_dev_calibration_begin(MCP7940_Device *device, MCP7940_Reference reference)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Calibration_Begin);
+
+        unsigned long epoch;
+        unsigned long time;
+
+        device->calibration_epoch = 0;
+
+        MCP7940_Error error = mcp7940_calibration_edge(device, reference, &epoch, &time);
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Calibration_Begin, error);
+        }
+        device->calibration_epoch = epoch;
+        device->calibration_reference = time;
+
+        return mcp7940_trace(MCP7940_Trace_Calibration_Begin, MCP7940_Error_None);
+    }
+
+    /**
+     * @brief Closes the drift measurement window and applies the resulting OSCTRIM value.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param reference Function that returns the reference time in milliseconds (the same clock as passed to mcp7940_calibration_begin()).
+     *
+     * @param ppm Optional pointer (may be NULL) that receives the measured deviation in ppm (positive if the RTC runs fast).
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the new trim value was applied, verified and stored in the SRAM.
+     * - `MCP7940_Error_Fail` if no window is open, the window is shorter than one second, no seconds edge was detected, or the trim value could not be verified.
+     * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a transaction failed on the bus. The window stays open if the failure occurred while detecting the closing edge, so the call can be repeated.
+     *
+     * @details
+     * This function is available only when @c MCP7940_CALIBRATION_EN is defined. The end of the window is aligned to a seconds edge in the same way as the start, so the RTC interval is an exact number of seconds and the deviation follows from the reference interval. The resolution is the edge jitter (about one RTCSEC read) divided by the window length, so a window of at least 1000 seconds is recommended for a resolution of about 1 ppm.
+     *
+     * The deviation is combined with the trim that was in effect during the window and converted to the datasheet units: one fine step adds or subtracts 2 clock cycles per minute (about 1.017 ppm, up to 127 steps). If a larger correction is required, the CSTRIM bit is set and the value is applied 128 times per second (about 7812 ppm per step) instead, unless the MFP pin generates a square wave without @c MCP7940_SQW_CRSTRIM_EN, in which case the fine trim saturates. The value is applied with mcp7940_trimming() and stored with a CRC-8 at @c MCP7940_CALIBRATION_OFFSET of the SRAM.
+     */
+    MCP7940_Error mcp7940_dev_calibration_end(MCP7940_Device *device, MCP7940_Reference reference, long *ppm)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Calibration_End);
+
+        unsigned long epoch;
+        unsigned long time;
+
+        if(!device->calibration_epoch)
+        {
+            return mcp7940_trace(MCP7940_Trace_Calibration_End, MCP7940_Error_Fail);
+        }
+
+        MCP7940_Error status = mcp7940_calibration_edge(device, reference, &epoch, &time);
+
+        if(status != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Calibration_End, status);
+        }
+
+        unsigned long elapsed = ((time - device->calibration_reference) / 1000UL);
+        long deviation = (long)(((epoch - device->calibration_epoch) * 1000UL) - (time - device->calibration_reference));
+
+        device->calibration_epoch = 0;
+
+        if(!elapsed)
+        {
+            return mcp7940_trace(MCP7940_Trace_Calibration_End, MCP7940_Error_Fail);
+        }
+
+        long error = mcp7940_calibration_divide((deviation * 1000L), (long)elapsed);
+
+        if(ppm)
+        {
+            *ppm = error;
+        }
+
+        // Trim that was in effect during the window in fine steps (positive adds clocks)
+        unsigned char trim;
+        unsigned char control;
+
+        status = mcp7940_load(device, MCP7940_OSCTRIM, &trim);
+
+        if(status == MCP7940_Error_None)
+        {
+            status = mcp7940_load(device, MCP7940_CONTROL, &control);
+        }
+
+        if(status != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Calibration_End, status);
+        }
+        long steps = (trim & 0x7F);
+
+        if(!(trim & 0x80))
+        {
+            steps = -steps;
+        }
+
+        if(control & MCP7940_CSTRIM_bm)
+        {
+            steps *= MCP7940_CALIBRATION_COARSE;
+        }
+
+        // 1 ppm = 1966080 / 2000000 fine steps
+        steps -= mcp7940_calibration_divide((error * 3072L), 3125L);
+
+        return mcp7940_trace(MCP7940_Trace_Calibration_End, mcp7940_calibration_apply(device, steps));
+    }
+
+    /**
+     * @brief Applies the calibration stored in the MCP7940 SRAM.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if a valid calibration was found and applied.
+     * - `MCP7940_Error_Fail` if the stored calibration is invalid (e.g. the SRAM lost its content) or the trim value could not be verified.
+     * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a transaction failed on the bus.
+     *
+     * @details
+     * This function is available only when @c MCP7940_CALIBRATION_EN is defined and is called by mcp7940_init(), which resets the CONTROL register. The OSCTRIM value and the CSTRIM bit are only changed if the CRC-8 of the stored calibration matches.
+     */
+    MCP7940_Error mcp7940_dev_calibration_restore(MCP7940_Device *device)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Calibration_Restore);
+
+        unsigned char buffer[3];
+        MCP7940_Error error = mcp7940_dev_sram_read(device, MCP7940_CALIBRATION_OFFSET, buffer, sizeof(buffer));
+
+        if(error != MCP7940_Error_None)
+        {
+            return mcp7940_trace(MCP7940_Trace_Calibration_Restore, error);
+        }
+
+        if(mcp7940_crc8(buffer, 2) != buffer[2])
+        {
+            return mcp7940_trace(MCP7940_Trace_Calibration_Restore, MCP7940_Error_Fail);
+        }
+
+        #ifndef MCP7940_SQW_CRSTRIM_EN
+            unsigned char control;
+
+            error = mcp7940_load(device, MCP7940_CONTROL, &control);
+
+            if(error == MCP7940_Error_None)
+            {
+                error = mcp7940_write(device, MCP7940_CONTROL, ((control & ~MCP7940_CSTRIM_bm) | (buffer[1] & MCP7940_CSTRIM_bm)));
+            }
+
+            if(error != MCP7940_Error_None)
+            {
+                return mcp7940_trace(MCP7940_Trace_Calibration_Restore, error);
+            }
+        #endif
+
+        return mcp7940_trace(MCP7940_Trace_Calibration_Restore, mcp7940_dev_trimming(device, ((buffer[0] & 0x80) ? MCP7940_Trim_Add : MCP7940_Trim_Substract), buffer[0]));
+    }
+#endif
+
+#ifdef MCP7940_TICK_EN
+    /**
+     * @brief Synchronises the tick-synchronised clock with the current MCP7940 date and time.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the local copy was synchronised.
+     * - `MCP7940_Error_Fail` if no tear-free snapshot could be captured or an MFP edge occurred during each attempt. The time functions then keep reading the device.
+     * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a read failed on the bus. The local copy is invalidated as well.
+     *
+     * @details
+     * This function is available only when @c MCP7940_TICK_EN is defined and should be called once after mcp7940_init() and the oscillator start. A tear-free snapshot is captured as with mcp7940_datetime_atomic() and converted to Unix time. If mcp7940_tick_interrupt() was called while the registers were transferred, the snapshot cannot be assigned to an edge and is repeated. Further resyncs are performed automatically every @c MCP7940_TICK_RESYNC seconds.
+     */
+    MCP7940_Error mcp7940_dev_tick_sync(MCP7940_Device *device)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Tick_Sync);
+
+        unsigned char buffer[MCP7940_RTCC_SIZE];
+        MCP7940_Error error = MCP7940_Error_Fail;
+
+        for(unsigned char retry = 0; retry < MCP7940_ATOMIC_RETRIES; retry++)
+        {
+            unsigned char count = device->tick_count;
+            unsigned long epoch;
+
+            error = mcp7940_capture(device, buffer, MCP7940_RTCC_SIZE);
+
+            if(error == MCP7940_Error_None)
+            {
+                error = mcp7940_toepoch(buffer, &epoch);
+            }
+
+            if(error != MCP7940_Error_None)
+            {
+                break;
+            }
+
+            if(count == device->tick_count)
+            {
+                device->tick_epoch = epoch;
+                device->tick_base  = count;
+                device->tick_age   = 0;
+                device->tick_valid = 1;
+                device->tick_wrap  = 0;
+                return mcp7940_trace(MCP7940_Trace_Tick_Sync, MCP7940_Error_None);
+            }
+            error = MCP7940_Error_Fail;
+        }
+        device->tick_valid = 0;
+        return mcp7940_trace(MCP7940_Trace_Tick_Sync, error);
+    }
+
+    /**
+     * @brief Advances the tick-synchronised clock by one second.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @details
+     * This function is available only when @c MCP7940_TICK_EN is defined and has to be called from the interrupt service routine of the pin the MFP output is connected to, on the edge of the 1 Hz square wave that coincides with the seconds increment of the device. It only increments an 8-bit counter, which is an atomic operation, so no locking between the interrupt and the time functions is required. The counter is folded into the local copy by the next time request. If 256 or more edges pass without a time request, the counter wraps around the last folded value; this is flagged here, and the next time request performs a resync instead of folding the counter.
+     */
+    void mcp7940_dev_tick_interrupt(MCP7940_Device *device)
+    {
+        #ifdef MCP7940_TICK_MS
+            // Latched before the count is incremented, so a reader that sees the same count before and after reading the latch got the matching value
+            device->tick_ms = MCP7940_TICK_MS();
+        #endif
+        unsigned char count = (device->tick_count + 1);
+
+        device->tick_count = count;
+
+        if(count == device->tick_base)
+        {
+            device->tick_wrap = 1;
+        }
+    }
+
+    static MCP7940_Error mcp7940_tick_fold(MCP7940_Device *device)
+    {
+        if(!device->tick_valid)
+        {
+            return MCP7940_Error_Fail;
+        }
+
+        // The difference of the 8-bit counters is ambiguous once it wrapped, so the local copy is discarded
+        if(device->tick_wrap)
+        {
+            return mcp7940_dev_tick_sync(device);
+        }
+
+        unsigned char count = device->tick_count;
+        unsigned char delta = (count - device->tick_base);
+
+        device->tick_base   = count;
+        device->tick_epoch += delta;
+        device->tick_age   += delta;
+
+        if(device->tick_age >= MCP7940_TICK_RESYNC)
+        {
+            return mcp7940_dev_tick_sync(device);
+        }
+        return MCP7940_Error_None;
+    }
+
+    static MCP7940_Error mcp7940_tick_fetch(MCP7940_Device *device, unsigned char *buffer)
+    {
+        MCP7940_Error error = mcp7940_tick_fold(device);
+
+        if(error == MCP7940_Error_None)
+        {
+            mcp7940_fromepoch(device->tick_epoch, buffer);
+        }
+        return error;
+    }
+
+    #ifdef MCP7940_TICK_MS
+        /**
+         * @brief Returns the current MCP7940 date and time with millisecond resolution.
+         *
+         * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+         *
+         * @param datetime Pointer to a ::FORMAT_DateTime structure that receives the date and time of the last MFP edge.
+         *
+         * @param millisecond Pointer that receives the milliseconds elapsed since that edge (0 to 999).
+         *
+         * @return Returns one of the following error codes:
+         * - `MCP7940_Error_None` if the timestamp was served from the tick-synchronised clock.
+         * - `MCP7940_Error_Fail` if the clock is not synchronised (see mcp7940_tick_sync()) or a due resync failed.
+         * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a due resync failed on the bus.
+         *
+         * @details
+         * This function is available only when @c MCP7940_TICK_EN and @c MCP7940_TICK_MS are defined. The seconds are taken from the tick-synchronised clock and the fraction is interpolated from the millisecond counter latched by mcp7940_tick_interrupt() at the last 1 Hz edge, so no bus access (except for the periodic resync) and no high-frequency square wave are required. The edge count, the latched counter and the current counter are read consistently without disabling interrupts. Until the first edge after a sync, or if an edge was missed, the fraction is limited to 999.
+         */
+        MCP7940_Error mcp7940_dev_tick_timestamp(MCP7940_Device *device, FORMAT_DateTime *datetime, unsigned int *millisecond)
+        {
+            MCP7940_TRACE_BEGIN(MCP7940_Trace_Tick_Timestamp);
+
+            MCP7940_Error error = mcp7940_tick_fold(device);
+
+            if(error != MCP7940_Error_None)
+            {
+                return mcp7940_trace(MCP7940_Trace_Tick_Timestamp, error);
+            }
+
+            unsigned char count;
+            unsigned int latch;
+            unsigned int now;
+
+            do
+            {
+                count = device->tick_count;
+                latch = device->tick_ms;
+                now   = MCP7940_TICK_MS();
+            } while(count != device->tick_count);
+
+            unsigned char buffer[MCP7940_RTCC_SIZE];
+
+            mcp7940_fromepoch((device->tick_epoch + (unsigned char)(count - device->tick_base)), buffer);
+            mcp7940_decode_time(buffer, &datetime->time);
+            mcp7940_decode_date(buffer, &datetime->date);
+
+            now -= latch;
+            *millisecond = (now > 999U) ? 999U : now;
+
+            return mcp7940_trace(MCP7940_Trace_Tick_Timestamp, MCP7940_Error_None);
+        }
+    #endif
+#endif
+
+#ifdef MCP7940_QUEUE_EN
+    #define MCP7940_REQUEST_READ     0x00
+    #define MCP7940_REQUEST_STATUS   0x01
+    #define MCP7940_REQUEST_DATETIME 0x02
+    #define MCP7940_REQUEST_WRITE    0x80
+
+    static unsigned char mcp7940_queue_end(const MCP7940_Request *request)
+    {
+        return (request->address + request->length);
+    }
+
+    static MCP7940_Error mcp7940_queue_add(MCP7940_Device *device, unsigned char type, unsigned char address, void *data, unsigned char length)
+    {
+        // The address pointer wraps inside the RTCC (0x00-0x1F) and SRAM (0x20-0x5F) block, so a request must not cross the end of its block
+        unsigned char limit = (address < MCP7940_SRAM) ? MCP7940_SRAM : (MCP7940_SRAM + MCP7940_SRAM_SIZE);
+
+        if(!length || (device->queue_length >= MCP7940_QUEUE_SIZE) || (address >= limit) || (length > (limit - address)))
+        {
+            return MCP7940_Error_Fail;
+        }
+
+        unsigned char index = device->queue_length;
+
+        for(unsigned char i = device->queue_length; i; i--)
+        {
+            const MCP7940_Request *request = &device->queue[i - 1];
+
+            // Reads are executed before writes, so a request overlapping a queued write would see a different result than with sequential calls
+            if((request->type == MCP7940_REQUEST_WRITE) && (address < mcp7940_queue_end(request)) && (request->address < (address + length)))
+            {
+                return MCP7940_Error_Fail;
+            }
+
+            if(request->address > address)
+            {
+                index = (i - 1);
+            }
+        }
+
+        for(unsigned char i = device->queue_length; i > index; i--)
+        {
+            device->queue[i] = device->queue[i - 1];
+        }
+
+        device->queue[index].type    = type;
+        device->queue[index].address = address;
+        device->queue[index].length  = length;
+        device->queue[index].data    = data;
+        device->queue_length++;
+
+        return MCP7940_Error_None;
+    }
+
+    /**
+     * @brief Queues a raw read of one or more consecutive MCP7940 registers.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param address First register address (RTCC registers 0x00 to 0x1F or SRAM 0x20 to 0x5F, see e.g. @c MCP7940_OSCTRIM or @c MCP7940_SRAM).
+     *
+     * @param data Pointer to a buffer with at least @p length bytes that receives the register content during mcp7940_queue_flush().
+     *
+     * @param length Number of registers to read. The range must not cross the end of the RTCC or SRAM block.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the request was queued.
+     * - `MCP7940_Error_Fail` if the range is invalid, the queue is full or the range overlaps a queued write.
+     *
+     * @details
+     * This function is available only when @c MCP7940_QUEUE_EN is defined and does not access the bus.
+     */
+    MCP7940_Error mcp7940_dev_queue_read(MCP7940_Device *device, unsigned char address, unsigned char *data, unsigned char length)
+    {
+        return mcp7940_queue_add(device, MCP7940_REQUEST_READ, address, data, length);
+    }
+
+    /**
+     * @brief Queues a raw write of one or more consecutive MCP7940 registers.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param address First register address (RTCC registers 0x00 to 0x1F or SRAM 0x20 to 0x5F).
+     *
+     * @param data Pointer to the @p length bytes that should be written. The data is not copied and has to remain valid until mcp7940_queue_flush() has been called.
+     *
+     * @param length Number of registers to write. The range must not cross the end of the RTCC or SRAM block.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the request was queued.
+     * - `MCP7940_Error_Fail` if the range is invalid, the queue is full or the range overlaps another queued write.
+     *
+     * @details
+     * This function is available only when @c MCP7940_QUEUE_EN is defined and does not access the bus. Since all queued reads are executed first, a read that was queued before this write still returns the previous register content, as with sequential calls.
+     */
+    MCP7940_Error mcp7940_dev_queue_write(MCP7940_Device *device, unsigned char address, const unsigned char *data, unsigned char length)
+    {
+        // The buffer is only read by mcp7940_dev_queue_flush() for a write request
+        return mcp7940_queue_add(device, MCP7940_REQUEST_WRITE, address, (void *)data, length);
+    }
+
+    /**
+     * @brief Queues a read of the MCP7940 status flags.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param status Pointer that receives the same ::MCP7940_Status value as mcp7940_status() during mcp7940_queue_flush().
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the request was queued.
+     * - `MCP7940_Error_Fail` if the queue is full or RTCWKDAY is written by a queued request.
+     */
+    MCP7940_Error mcp7940_dev_queue_status(MCP7940_Device *device, MCP7940_Status *status)
+    {
+        return mcp7940_queue_add(device, MCP7940_REQUEST_STATUS, MCP7940_RTCWKDAY, status, 1);
+    }
+
+    /**
+     * @brief Queues a read of the current MCP7940 date and time.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param datetime Pointer to a ::FORMAT_DateTime structure that receives the same values as mcp7940_datetime() with `MCP7940_Register_Current_Time` during mcp7940_queue_flush().
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the request was queued.
+     * - `MCP7940_Error_Fail` if the queue is full or one of the timekeeping registers is written by a queued request.
+     */
+    MCP7940_Error mcp7940_dev_queue_datetime(MCP7940_Device *device, FORMAT_DateTime *datetime)
+    {
+        return mcp7940_queue_add(device, MCP7940_REQUEST_DATETIME, MCP7940_RTCSEC, datetime, MCP7940_RTCC_SIZE);
+    }
+
+    /**
+     * @brief Executes all queued MCP7940 requests with the minimal number of bus transactions.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param transactions Optional pointer (may be NULL) that receives the number of TWI/I2C transactions that have been issued.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if all queued requests have been executed.
+     * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a transaction failed on the bus. The remaining requests are discarded and their buffers are not modified.
+     *
+     * @details
+     * This function is available only when @c MCP7940_QUEUE_EN is defined. The queue is kept sorted by register address. First, reads whose ranges are at most @c MCP7940_QUEUE_GAP registers apart (and in the same RTCC or SRAM block) are combined into one sequential read into a local buffer of @c MCP7940_SRAM_SIZE bytes, from which every request receives its result. Afterwards contiguous writes in the same block are gathered into the buffer and issued as one sequential write each in ascending address order. For example, mcp7940_queue_status(), mcp7940_queue_datetime() and a raw read of @c MCP7940_OSCTRIM are served by a single 9-byte read instead of three transactions. The queue is empty afterwards.
+     */
+    MCP7940_Error mcp7940_dev_queue_flush(MCP7940_Device *device, unsigned char *transactions)
+    {
+        MCP7940_TRACE_BEGIN(MCP7940_Trace_Queue_Flush);
+
+        unsigned char buffer[MCP7940_SRAM_SIZE];
+        unsigned char count = 0;
+        MCP7940_Error error = MCP7940_Error_None;
+
+        for(unsigned char i = 0; (i < device->queue_length) && (error == MCP7940_Error_None); i++)
+        {
+            if(device->queue[i].type == MCP7940_REQUEST_WRITE)
+            {
+                continue;
+            }
+
+            unsigned char start = device->queue[i].address;
+            unsigned char end   = mcp7940_queue_end(&device->queue[i]);
+            unsigned char last  = i;
+
+            for(unsigned char k = (i + 1); k < device->queue_length; k++)
+            {
+                const MCP7940_Request *request = &device->queue[k];
+
+                if(request->type == MCP7940_REQUEST_WRITE)
+                {
+                    continue;
+                }
+
+                if((request->address > (end + MCP7940_QUEUE_GAP)) || ((request->address < MCP7940_SRAM) != (start < MCP7940_SRAM)))
+                {
+                    break;
+                }
+
+                if(mcp7940_queue_end(request) > end)
+                {
+                    end = mcp7940_queue_end(request);
+                }
+                last = k;
+            }
+
+            error = mcp7940_read_burst(device, start, buffer, (end - start));
+            count++;
+
+            if(error != MCP7940_Error_None)
+            {
+                break;
+            }
+
+            for(unsigned char k = i; k <= last; k++)
+            {
+                const MCP7940_Request *request = &device->queue[k];
+                const unsigned char *temp = &buffer[request->address - start];
+
+                switch (request->type)
+                {
+                    case MCP7940_REQUEST_STATUS:
+                        *(MCP7940_Status *)request->data = (temp[0] & (MCP7940_OSCRUN_bm | MCP7940_PWRFAIL_bm | MCP7940_VBATEN_bm));
+                    break;
+                    case MCP7940_REQUEST_DATETIME:
+                        mcp7940_decode_time(temp, &((FORMAT_DateTime *)request->data)->time);
+                        mcp7940_decode_date(temp, &((FORMAT_DateTime *)request->data)->date);
+                    break;
+                    case MCP7940_REQUEST_READ:
+                        for(unsigned char j = 0; j < request->length; j++)
+                        {
+                            ((unsigned char *)request->data)[j] = temp[j];
+                        }
+                    break;
+                    default:
+                    break;
+                }
+            }
+            i = last;
+        }
+
+        for(unsigned char i = 0; (i < device->queue_length) && (error == MCP7940_Error_None); i++)
+        {
+            if(device->queue[i].type != MCP7940_REQUEST_WRITE)
+            {
+                continue;
+            }
+
+            unsigned char start  = device->queue[i].address;
+            unsigned char length = 0;
+
+            for(unsigned char k = i; k < device->queue_length; k++)
+            {
+                const MCP7940_Request *request = &device->queue[k];
+
+                if(request->type != MCP7940_REQUEST_WRITE)
+                {
+                    continue;
+                }
+
+                // The address pointer wraps inside the RTCC and the SRAM block, so a write must not continue into the next block
+                if((request->address != (start + length)) || ((request->address < MCP7940_SRAM) != (start < MCP7940_SRAM)))
+                {
+                    break;
+                }
+
+                for(unsigned char j = 0; j < request->length; j++)
+                {
+                    buffer[length++] = ((const unsigned char *)request->data)[j];
+                }
+                i = k;
+            }
+
+            error = mcp7940_write_burst(device, start, buffer, length);
+            count++;
+        }
+
+        if(transactions)
+        {
+            *transactions = count;
+        }
+        device->queue_length = 0;
+        return mcp7940_trace(MCP7940_Trace_Queue_Flush, error);
+    }
+#endif
+
+#ifdef MCP7940_ASYNC_EN
+    enum MCP7940_Async_State_t
+    {
+        MCP7940_Async_Idle = 0,
+        MCP7940_Async_Start,
+        MCP7940_Async_Address,
+        MCP7940_Async_Register,
+        MCP7940_Async_Write,
+        MCP7940_Async_Restart,
+        MCP7940_Async_Read,
+        MCP7940_Async_Stop
+    };
+    typedef enum MCP7940_Async_State_t MCP7940_Async_State;
+
+    static struct
+    {
+        volatile MCP7940_Async_State state;
+        MCP7940_Device *device;
+        MCP7940_Async_Callback callback;
+        unsigned char address;
+        unsigned char read;
+        unsigned char *data;
+        unsigned char length;
+        unsigned char index;
+        MCP7940_Error error;
+        FORMAT_DateTime *datetime;
+        unsigned char buffer[MCP7940_RTCC_SIZE];
+    } mcp7940_async;
+
+    /**
+     * @brief Checks whether an asynchronous MCP7940 transfer is in progress.
+     *
+     * @return Non-zero while a queued transfer has not completed yet, otherwise 0.
+     */
+    unsigned char mcp7940_async_busy(void)
+    {
+        return (mcp7940_async.state != MCP7940_Async_Idle);
+    }
+
+    static MCP7940_Error mcp7940_async_begin(MCP7940_Device *device, unsigned char address, unsigned char read, unsigned char *data, unsigned char length, FORMAT_DateTime *datetime, MCP7940_Async_Callback callback)
+    {
+        if(mcp7940_async_busy())
+        {
+            return MCP7940_Error_Fail;
+        }
+
+        mcp7940_async.device   = device;
+        mcp7940_async.callback = callback;
+        mcp7940_async.address  = address;
+        mcp7940_async.read     = read;
+        mcp7940_async.data     = data;
+        mcp7940_async.length   = length;
+        mcp7940_async.index    = 0;
+        mcp7940_async.error    = MCP7940_Error_None;
+        mcp7940_async.datetime = datetime;
+
+        // Set last, the transfer may be advanced from an interrupt as soon as it is queued
+        mcp7940_async.state    = MCP7940_Async_Start;
+
+        return MCP7940_Error_None;
+    }
+
+    /**
+     * @brief Starts a non-blocking read of the current MCP7940 date and time.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param datetime Pointer to a ::FORMAT_DateTime structure that receives the decoded date and time. It has to remain valid until @p callback has been called.
+     *
+     * @param callback Function (may be NULL) that is called by mcp7940_async_poll() once the transfer has completed.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the transfer was queued.
+     * - `MCP7940_Error_Fail` if another asynchronous transfer is still in progress.
+     *
+     * @details
+     * This function is available only when @c MCP7940_ASYNC_EN is defined. It queues one sequential read of RTCSEC to RTCYEAR (the same burst as mcp7940_datetime()) and returns without a bus access. The registers are decoded into @p datetime right before @p callback is called.
+     */
+    MCP7940_Error mcp7940_dev_datetime_async(MCP7940_Device *device, FORMAT_DateTime *datetime, MCP7940_Async_Callback callback)
+    {
+        return mcp7940_async_begin(device, MCP7940_RTCSEC, 1, mcp7940_async.buffer, MCP7940_RTCC_SIZE, datetime, callback);
+    }
+
+    /**
+     * @brief Starts a non-blocking write of the current MCP7940 time.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param time Pointer to a ::FORMAT_Time structure with the time to be set. It is encoded immediately and does not need to remain valid.
+     *
+     * @param callback Function (may be NULL) that is called by mcp7940_async_poll() once the transfer has completed.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the transfer was queued.
+     * - `MCP7940_Error_Fail` if @p time is invalid according to validate_time() or another asynchronous transfer is still in progress.
+     *
+     * @details
+     * This function is available only when @c MCP7940_ASYNC_EN is defined. It queues the same sequential write of RTCSEC to RTCHOUR as mcp7940_settime(), including the ST bit. With @c MCP7940_USE_EXTOSC the external clock input is not touched.
+     */
+    MCP7940_Error mcp7940_dev_settime_async(MCP7940_Device *device, const FORMAT_Time *time, MCP7940_Async_Callback callback)
+    {
+        if((validate_time(time) != RETURN_Valid) || mcp7940_async_busy())
+        {
+            return MCP7940_Error_Fail;
+        }
+        mcp7940_encode_time(time, mcp7940_async.buffer);
+
+        return mcp7940_async_begin(device, MCP7940_RTCSEC, 0, mcp7940_async.buffer, 3, 0, callback);
+    }
+
+    /**
+     * @brief Starts a non-blocking write of the current MCP7940 calendar date.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param date Pointer to a ::FORMAT_Date structure with the date to be set. It is encoded immediately and does not need to remain valid.
+     *
+     * @param callback Function (may be NULL) that is called by mcp7940_async_poll() once the transfer has completed.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the transfer was queued.
+     * - `MCP7940_Error_Fail` if @p date is invalid according to validate_date() or another asynchronous transfer is still in progress.
+     *
+     * @details
+     * This function is available only when @c MCP7940_ASYNC_EN is defined. It queues the same sequential write of RTCDATE to RTCYEAR as mcp7940_setdate().
+     */
+    MCP7940_Error mcp7940_dev_setdate_async(MCP7940_Device *device, const FORMAT_Date *date, MCP7940_Async_Callback callback)
+    {
+        if((validate_date(date) != RETURN_Valid) || mcp7940_async_busy())
+        {
+            return MCP7940_Error_Fail;
+        }
+        mcp7940_encode_date(date, mcp7940_async.buffer);
+
+        return mcp7940_async_begin(device, MCP7940_RTCDATE, 0, &mcp7940_async.buffer[MCP7940_RTCDATE], 3, 0, callback);
+    }
+
+    /**
+     * @brief Starts a non-blocking read of a block of the MCP7940 battery-backed SRAM.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param offset Byte offset inside the SRAM block (0 to @c MCP7940_SRAM_SIZE - 1), relative to @c MCP7940_SRAM.
+     *
+     * @param data Pointer to a buffer with at least @p length bytes that receives the SRAM content. It has to remain valid until @p callback has been called.
+     *
+     * @param length Number of bytes to read (at least 1).
+     *
+     * @param callback Function (may be NULL) that is called by mcp7940_async_poll() once the transfer has completed.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the transfer was queued.
+     * - `MCP7940_Error_Fail` if the range is invalid, @p length is 0 or another asynchronous transfer is still in progress.
+     *
+     * @details
+     * This function is available only when @c MCP7940_ASYNC_EN is defined. The range check is the same as for mcp7940_sram_read().
+     */
+    MCP7940_Error mcp7940_dev_sram_read_async(MCP7940_Device *device, unsigned char offset, unsigned char *data, unsigned char length, MCP7940_Async_Callback callback)
+    {
+        if(!length || (mcp7940_sram_range(offset, length) != MCP7940_Error_None))
+        {
+            return MCP7940_Error_Fail;
+        }
+        return mcp7940_async_begin(device, (MCP7940_SRAM + offset), 1, data, length, 0, callback);
+    }
+
+    /**
+     * @brief Starts a non-blocking write of a block of the MCP7940 battery-backed SRAM.
+     *
+     * @param device Pointer to the ::MCP7940_Device handle of the RTC.
+     *
+     * @param offset Byte offset inside the SRAM block (0 to @c MCP7940_SRAM_SIZE - 1), relative to @c MCP7940_SRAM.
+     *
+     * @param data Pointer to the @p length bytes that should be stored. It has to remain valid until @p callback has been called.
+     *
+     * @param length Number of bytes to write (at least 1).
+     *
+     * @param callback Function (may be NULL) that is called by mcp7940_async_poll() once the transfer has completed.
+     *
+     * @return Returns one of the following error codes:
+     * - `MCP7940_Error_None` if the transfer was queued.
+     * - `MCP7940_Error_Fail` if the range is invalid, @p length is 0 or another asynchronous transfer is still in progress.
+     *
+     * @details
+     * This function is available only when @c MCP7940_ASYNC_EN is defined. The range check is the same as for mcp7940_sram_write().
+     */
+    MCP7940_Error mcp7940_dev_sram_write_async(MCP7940_Device *device, unsigned char offset, const unsigned char *data, unsigned char length, MCP7940_Async_Callback callback)
+    {
+        if(!length || (mcp7940_sram_range(offset, length) != MCP7940_Error_None))
+        {
+            return MCP7940_Error_Fail;
+        }
+        // The buffer is only read by the engine for a write transfer
+        return mcp7940_async_begin(device, (MCP7940_SRAM + offset), 0, (unsigned char *)data, length, 0, callback);
+    }
+
+    /**
+     * @brief Advances the asynchronous MCP7940 transfer by one bus step.
+     *
+     * @details
+     * This function is available only when @c MCP7940_ASYNC_EN is defined. If a transfer is queued and @c MCP7940_TWI_BUSY (the @c busy operation of the ::MCP7940_Bus of the device with @c MCP7940_MULTI_DEVICE) reports an idle bus, exactly one TWI/I2C primitive is executed: start condition, address, register pointer, one data byte or the stop condition. A complete 7-byte datetime read therefore takes 12 calls, each of which only blocks for a single byte on the bus. After the stop condition, the shadow copies are updated, a datetime read is decoded and the completion callback is called. If a step fails, the remaining bytes are skipped, the next call issues the stop condition and the callback receives the error code of the failed step; asynchronous transfers are not retried, the caller decides whether to queue the transfer again. The function can be called periodically from the main loop (bare-metal) or from the TWI interrupt routine. In the latter case the callback is executed in interrupt context as well. A new transfer may be queued from within the callback.
+     */
+    void mcp7940_async_poll(void)
+    {
+        if((mcp7940_async.state == MCP7940_Async_Idle) || MCP7940_BUS_BUSY(mcp7940_async.device))
+        {
+            return;
+        }
+
+        MCP7940_Device *device = mcp7940_async.device;
+        MCP7940_Error error = MCP7940_Error_None;
+
+        switch (mcp7940_async.state)
+        {
+            case MCP7940_Async_Start:
+                error = MCP7940_BUS_START(device);
+                mcp7940_async.state = MCP7940_Async_Address;
+            break;
+            case MCP7940_Async_Address:
+                error = MCP7940_BUS_ADDRESS(device, TWI_WRITE);
+                mcp7940_async.state = MCP7940_Async_Register;
+            break;
+            case MCP7940_Async_Register:
+                error = MCP7940_BUS_SET(device, mcp7940_async.address);
+                mcp7940_async.state = mcp7940_async.read ? MCP7940_Async_Restart : MCP7940_Async_Write;
+            break;
+            case MCP7940_Async_Write:
+                error = MCP7940_BUS_SET(device, mcp7940_async.data[mcp7940_async.index++]);
+
+                if(mcp7940_async.index == mcp7940_async.length)
+                {
+                    mcp7940_async.state = MCP7940_Async_Stop;
+                }
+            break;
+            case MCP7940_Async_Restart:
+                error = MCP7940_BUS_ADDRESS(device, TWI_READ);
+                mcp7940_async.state = MCP7940_Async_Read;
+            break;
+            case MCP7940_Async_Read:
+                if((mcp7940_async.index + 1) < mcp7940_async.length)
+                {
+                    error = MCP7940_BUS_GET(device, &mcp7940_async.data[mcp7940_async.index++], TWI_ACK);
+                    break;
+                }
+                error = MCP7940_BUS_GET(device, &mcp7940_async.data[mcp7940_async.index++], TWI_NACK);
+                mcp7940_async.state = MCP7940_Async_Stop;
+            break;
+            default:
+            {
+                MCP7940_BUS_STOP(device);
+
+                if(mcp7940_async.error == MCP7940_Error_None)
+                {
+                    mcp7940_shadow_update(device, mcp7940_async.address, mcp7940_async.data, mcp7940_async.length);
+
+                    if(mcp7940_async.datetime)
+                    {
+                        mcp7940_decode_time(mcp7940_async.buffer, &mcp7940_async.datetime->time);
+                        mcp7940_decode_date(mcp7940_async.buffer, &mcp7940_async.datetime->date);
+                    }
+                }
+                mcp7940_async.datetime = 0;
+
+                // Released before the callback, so the callback can queue the next transfer
+                MCP7940_Async_Callback callback = mcp7940_async.callback;
+                error = mcp7940_async.error;
+                mcp7940_async.state = MCP7940_Async_Idle;
+
+                if(callback)
+                {
+                    callback(error);
+                }
+            }
+            return;
+        }
+
+        // A failed step skips the remaining bytes, the stop condition releases the bus and the callback reports the error
+        if(error != MCP7940_Error_None)
+        {
+            mcp7940_async.error = error;
+            mcp7940_async.state = MCP7940_Async_Stop;
+        }
+    }
+#endif
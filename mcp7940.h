@@ -61,6 +61,45 @@
         #endif
     #endif
 
+    #define MCP7940_VARIANT_M     0x00
+    #define MCP7940_VARIANT_N     0x01
+    #define MCP7940_VARIANT_79410 0x02
+    #define MCP7940_VARIANT_79411 0x03
+    #define MCP7940_VARIANT_79412 0x04
+
+    #ifndef MCP7940_VARIANT
+        /**
+         * @def MCP7940_VARIANT
+         * @brief Selects the device variant of the MCP7940 family the driver is compiled for.
+         *
+         * The variants share the RTCC and SRAM register map but differ in their additional features. The selection defines the feature macros @c MCP7940_HAS_BATTERY, @c MCP7940_HAS_EEPROM and @c MCP7940_HAS_EUI, and code paths of features that are not available (e.g. battery backup and power-fail timestamps on the MCP7940M) are left out entirely, so a call of an unsupported function fails at build time.
+         *
+         * The following variant values are available:
+         *  - MCP7940_VARIANT_M:     MCP7940M without battery backup.
+         *  - MCP7940_VARIANT_N:     MCP7940N with battery backup and power-fail timestamps.
+         *  - MCP7940_VARIANT_79410: MCP79410 additionally with 1 Kbit EEPROM and a user-programmable unique ID.
+         *  - MCP7940_VARIANT_79411: MCP79411 additionally with a pre-programmed EUI-48.
+         *  - MCP7940_VARIANT_79412: MCP79412 additionally with a pre-programmed EUI-64.
+         *
+         * @note If MCP7940_VARIANT is not explicitly defined in the project configuration, it defaults to MCP7940_VARIANT_N.
+         */
+        #define MCP7940_VARIANT MCP7940_VARIANT_N
+    #endif
+
+    #if MCP7940_VARIANT != MCP7940_VARIANT_M
+        #define MCP7940_HAS_BATTERY /**< Defined if the variant provides battery backup (VBAT) and power-fail timestamps. */
+    #endif
+
+    #if MCP7940_VARIANT >= MCP7940_VARIANT_79410
+        #define MCP7940_HAS_EEPROM  /**< Defined if the variant provides the 1 Kbit EEPROM and the protected unique ID area. */
+    #endif
+
+    #if MCP7940_VARIANT == MCP7940_VARIANT_79411
+        #define MCP7940_HAS_EUI 6   /**< Size of the pre-programmed EUI in bytes, only defined if the variant provides one. */
+    #elif MCP7940_VARIANT == MCP7940_VARIANT_79412
+        #define MCP7940_HAS_EUI 8
+    #endif
+
     #ifndef MCP7940_BATTERY_BACKUP_EN
         /** 
          * @def MCP7940_BATTERY_BACKUP_EN
@@ -79,12 +118,16 @@
         #endif
     #endif
 
+    #if defined(MCP7940_BATTERY_BACKUP_EN) && !defined(MCP7940_HAS_BATTERY)
+        #error "MCP7940_BATTERY_BACKUP_EN requires a variant with battery backup (check MCP7940_VARIANT)"
+    #endif
+
 
-    #ifndef MCP7940_MFP_MODE
-        #define MCP7940_MFP_MODE_OUTPUT      0x00
-        #define MCP7940_MFP_MODE_SQUARE_WAVE 0x01
-        #define MCP7940_MFP_MODE_ALARM       0x02
+    #define MCP7940_MFP_MODE_OUTPUT      0x00
+    #define MCP7940_MFP_MODE_SQUARE_WAVE 0x01
+    #define MCP7940_MFP_MODE_ALARM       0x02
 
+    #ifndef MCP7940_MFP_MODE
         /**
          * @def MCP7940_MFP_MODE
          * @brief Selects the operating mode of the MCP7940 multi-function pin (MFP).
@@ -157,7 +200,7 @@
     #endif
 
     #define MCP7940_MFP_ALARM_POLARITY_NORMAL 0x00
-    #define MCP7940_MFP_ALARM_POLARITY_INVERTED RTC_ALMPOL_bm
+    #define MCP7940_MFP_ALARM_POLARITY_INVERTED MCP7940_ALARM_ALMPOL_bm
 
     #ifndef MCP7940_MFP_ALARM1_POLARITY
 
@@ -193,6 +236,90 @@
         #define MCP7940_MFP_ALARM2_POLARITY MCP7940_MFP_ALARM_POLARITY_NORMAL
     #endif
 
+    #define MCP7940_HOUR_FORMAT_24 0x00
+    #define MCP7940_HOUR_FORMAT_12 0x40
+
+    #ifndef MCP7940_HOUR_FORMAT
+        /**
+         * @def MCP7940_HOUR_FORMAT
+         * @brief Selects the hour format in which the driver writes the time and alarm registers.
+         *
+         * The ::FORMAT_Time structure of the API always holds the hour in 24-hour format (0 to 23). Reads decode both formats, the 12/24-hour bit and the AM/PM bit are taken from the hour byte of the same transfer, so a device that was set to 12-hour mode by other firmware returns correct times without an additional read. Writes (mcp7940_settime(), mcp7940_setdatetime(), mcp7940_setepoch(), mcp7940_alarm_set(), ...) encode the hour in the selected format, so the alarm registers always match the format of the time registers.
+         *
+         * The following values are available:
+         *  - MCP7940_HOUR_FORMAT_24: The hours register counts from 0 to 23.
+         *  - MCP7940_HOUR_FORMAT_12: The hours register counts from 1 to 12 with the AM/PM bit.
+         *
+         * @note If MCP7940_HOUR_FORMAT is not explicitly defined in the project configuration, it defaults to MCP7940_HOUR_FORMAT_24.
+         */
+        #define MCP7940_HOUR_FORMAT MCP7940_HOUR_FORMAT_24
+    #endif
+
+    #ifndef MCP7940_ASYNC_EN
+        /**
+         * @def MCP7940_ASYNC_EN
+         * @brief Enables the non-blocking asynchronous transaction engine of the MCP7940 driver.
+         *
+         * When this macro is defined, functions like mcp7940_datetime_async() or mcp7940_settime_async() only queue a transfer and return immediately. The transfer is then executed by mcp7940_async_poll(), one TWI/I2C primitive (start, address, data byte or stop) per call, as long as @c MCP7940_TWI_BUSY (or the @c busy operation of the ::MCP7940_Bus with @c MCP7940_MULTI_DEVICE) reports an idle bus. Completion is signalled through a callback. mcp7940_async_poll() can be called from the main loop or from the TWI interrupt routine.
+         *
+         * While an asynchronous transfer is in progress, the blocking functions do not access the bus and return `MCP7940_Error_Fail`, because their start condition would break into the queued transfer. mcp7940_async_busy() reports when the blocking API can be used again, which is already the case inside the completion callback.
+         *
+         * @note Define `MCP7940_ASYNC_EN` in the project configuration to enable the asynchronous functions. Leave it undefined (default) if only the blocking API is used.
+         */
+        //#define MCP7940_ASYNC_EN
+
+        #ifdef _DOXYGEN_    // Used for documentation, can be ignored
+            #define MCP7940_ASYNC_EN
+        #endif
+    #endif
+
+    #define MCP7940_IO_WAIT_NONE    0x00
+    #define MCP7940_IO_WAIT_DELAY   0x01
+    #define MCP7940_IO_WAIT_RUNTIME 0x02
+
+    #ifndef MCP7940_IO_WAIT
+        /**
+         * @def MCP7940_IO_WAIT
+         * @brief Selects how the driver waits after each TWI/I2C transaction with the MCP7940.
+         *
+         * The RTCC and SRAM registers of the MCP7940 have no write cycle time, so a fixed delay after every access is not required by the device itself. This macro selects the wait strategy at compile time.
+         *
+         * The following values are available:
+         *  - MCP7940_IO_WAIT_NONE:    No wait at all, the next transaction is started immediately after the stop condition.
+         *  - MCP7940_IO_WAIT_DELAY:   Blocks for @c MCP7940_IO_TIMEOUT_MS via systick_timer_wait_ms() after every transaction.
+         *  - MCP7940_IO_WAIT_RUNTIME: The strategy is selected at runtime with mcp7940_waitmode() and may additionally poll the TWI status (see @c MCP7940_TWI_BUSY).
+         *
+         * @note If MCP7940_IO_WAIT is not explicitly defined in the project configuration, it defaults to MCP7940_IO_WAIT_DELAY to keep the timing of previous releases.
+         */
+        #define MCP7940_IO_WAIT MCP7940_IO_WAIT_DELAY
+    #endif
+
+    #if (MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME) || defined(MCP7940_ASYNC_EN)
+        #ifndef MCP7940_TWI_BUSY
+            /**
+             * @def MCP7940_TWI_BUSY
+             * @brief Evaluates to non-zero while the TWI/I2C bus has not yet returned to the idle state.
+             *
+             * This macro is used by the polled wait mode (`MCP7940_Wait_Poll`) and the asynchronous transaction engine (@c MCP7940_ASYNC_EN), with @c MCP7940_MULTI_DEVICE through the @c busy operation of ::mcp7940_twi, and should be mapped to the status query of the used hardware abstraction layer, e.g. `((TWI0.MSTATUS & TWI_BUSSTATE_gm) != TWI_BUSSTATE_IDLE_gc)` on AVR0/1 devices.
+             *
+             * @note If MCP7940_TWI_BUSY is not explicitly defined in the project configuration, it defaults to 0, which is correct for HAL implementations that complete every transfer synchronously before returning.
+             */
+            #define MCP7940_TWI_BUSY() 0
+        #endif
+    #endif
+
+    #if MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME
+        #ifndef MCP7940_IO_POLL_LIMIT
+            /**
+             * @def MCP7940_IO_POLL_LIMIT
+             * @brief Maximum number of @c MCP7940_TWI_BUSY polls after a transaction in polled wait mode.
+             *
+             * @note If MCP7940_IO_POLL_LIMIT is not explicitly defined in the project configuration, it defaults to 1000.
+             */
+            #define MCP7940_IO_POLL_LIMIT 1000U
+        #endif
+    #endif
+
     #ifndef MCP7940_IO_TIMEOUT_MS
         /**
          * @def MCP7940_IO_TIMEOUT_MS
@@ -200,10 +327,58 @@
          *
          * This macro defines the maximum time the driver will wait for a TWI/I2C transaction with the MCP7940 device to complete before treating it as a timeout condition. It can be adjusted to match the timing requirements and performance characteristics of the target platform and bus speed.
          *
-         * @note If MCP7940_IO_TIMEOUT_MS is not explicitly defined in the project configuration, it defaults to 1 ms.
+         * @note If MCP7940_IO_TIMEOUT_MS is not explicitly defined in the project configuration, it defaults to 1 ms. The delay is only applied with @c MCP7940_IO_WAIT_DELAY or the runtime mode `MCP7940_Wait_Delay`.
          */
         #define MCP7940_IO_TIMEOUT_MS 1
     #endif
+
+    #ifndef MCP7940_IO_RETRIES
+        /**
+         * @def MCP7940_IO_RETRIES
+         * @brief Number of times a failed TWI/I2C transaction is repeated before the error is reported.
+         *
+         * A transaction is only repeated if it failed with `MCP7940_Error_Nack` or `MCP7940_Error_Arbitration`. A `MCP7940_Error_Timeout` (e.g. a stuck bus) is reported immediately, and every failed transaction ends the calling function without further bus accesses, so the application can reschedule instead of blocking.
+         *
+         * @note If MCP7940_IO_RETRIES is not explicitly defined in the project configuration, it defaults to 2 (at most 3 attempts). Set it to 0 to fail on the first error.
+         */
+        #define MCP7940_IO_RETRIES 2
+    #endif
+
+    #ifndef MCP7940_TWI_ERROR
+        /**
+         * @def MCP7940_TWI_ERROR
+         * @brief Maps the status returned by a TWI/I2C HAL primitive to an ::MCP7940_Error.
+         *
+         * The macro has to evaluate @p status exactly once. It can be mapped to the error codes of the used hardware abstraction layer to distinguish a lost arbitration or a bus timeout from a missing acknowledge, e.g. `(((status) == TWI_None) ? MCP7940_Error_None : (((status) == TWI_Arbitration) ? MCP7940_Error_Arbitration : MCP7940_Error_Nack))`.
+         *
+         * @note If MCP7940_TWI_ERROR is not explicitly defined in the project configuration, every status other than `TWI_None` is reported as `MCP7940_Error_Nack`.
+         */
+        #define MCP7940_TWI_ERROR(status) (((status) == TWI_None) ? MCP7940_Error_None : MCP7940_Error_Nack)
+    #endif
+
+    #ifndef MCP7940_TRACE_BEGIN
+        /**
+         * @def MCP7940_TRACE_BEGIN
+         * @brief Trace hook that is executed when a driver operation starts.
+         *
+         * The hook receives the operation as ::MCP7940_Trace value in @p op. It is placed at the start of every blocking public function, of the battery configuration in mcp7940_init(), of every bus transaction and of the wait after a transaction. Operations nest, e.g. `MCP7940_Trace_Init` contains `MCP7940_Trace_Battery` and `MCP7940_Trace_Oscillator`, which in turn contain their `MCP7940_Trace_Transfer` and `MCP7940_Trace_Wait` events. A profiler can map the hook to a timestamp capture, e.g. `#define MCP7940_TRACE_BEGIN(op) profiler_enter((op))`.
+         *
+         * @note If MCP7940_TRACE_BEGIN is not explicitly defined in the project configuration, it expands to nothing and the tracing is compiled out.
+         */
+        #define MCP7940_TRACE_BEGIN(op)
+    #endif
+
+    #ifndef MCP7940_TRACE_END
+        /**
+         * @def MCP7940_TRACE_END
+         * @brief Trace hook that is executed when a driver operation returns.
+         *
+         * The hook receives the operation as ::MCP7940_Trace value in @p op and the ::MCP7940_Error result in @p status. For functions that return a value instead of an error code (e.g. mcp7940_status()), @p status is the result of the underlying register read. Every @c MCP7940_TRACE_BEGIN is matched by exactly one @c MCP7940_TRACE_END of the same operation.
+         *
+         * @note If MCP7940_TRACE_END is not explicitly defined in the project configuration, it expands to nothing and the tracing is compiled out.
+         */
+        #define MCP7940_TRACE_END(op, status)
+    #endif
     
     #ifndef MCP7940_OSC_ENABLE_MS
         /**
@@ -218,7 +393,251 @@
          */
         #define MCP7940_OSC_ENABLE_MS 1000UL
     #endif
+
+    #ifndef MCP7940_OSC_POLL_MS
+        /**
+         * @def MCP7940_OSC_POLL_MS
+         * @brief Interval in milliseconds between two OSCRUN polls in mcp7940_oscillator_start().
+         *
+         * Each poll is one register read of RTCWKDAY. The interval is also the resolution of the start-up time reported by mcp7940_oscillator_start().
+         *
+         * @note If MCP7940_OSC_POLL_MS is not explicitly defined in the project configuration, it defaults to 10 ms.
+         */
+        #define MCP7940_OSC_POLL_MS 10U
+    #endif
     
+    #ifndef MCP7940_ATOMIC_RETRIES
+        /**
+         * @def MCP7940_ATOMIC_RETRIES
+         * @brief Maximum number of burst reads performed by mcp7940_datetime_atomic() to obtain a tear-free snapshot.
+         *
+         * A snapshot is discarded when the seconds register changed while the seven timekeeping registers were transferred, which indicates that a rollover (for example 23:59:59 to 00:00:00) may have produced a mixed result. The read is then repeated up to this number of times.
+         *
+         * @note If MCP7940_ATOMIC_RETRIES is not explicitly defined in the project configuration, it defaults to 3. Since a rollover can only happen once per second, a second attempt practically always succeeds.
+         */
+        #define MCP7940_ATOMIC_RETRIES 3
+    #endif
+
+    #ifndef MCP7940_OSC_STOP_RETRIES
+        /**
+         * @def MCP7940_OSC_STOP_RETRIES
+         * @brief Maximum number of OSCRUN polls after stopping the oscillator before the time registers are written.
+         *
+         * When the complete date and time is set with mcp7940_setdatetime(), the oscillator is stopped first and the driver waits until the OSCRUN flag clears, so that no increment can occur while the registers are written. Each poll is one register read of RTCWKDAY.
+         *
+         * @note If MCP7940_OSC_STOP_RETRIES is not explicitly defined in the project configuration, it defaults to 10.
+         */
+        #define MCP7940_OSC_STOP_RETRIES 10
+    #endif
+
+    #ifndef MCP7940_SHADOW_EN
+        /**
+         * @def MCP7940_SHADOW_EN
+         * @brief Enables shadow copies of the MCP7940 CONTROL, RTCWKDAY and OSCTRIM registers.
+         *
+         * When this macro is defined, the driver keeps the last value read from or written to these registers in RAM. Read-modify-write operations such as mcp7940_mfp_output(), mcp7940_setweekday(), mcp7940_alarm_enable() or the external oscillator control then only cost a single write instead of a read followed by a write. The shadow copies are filled by mcp7940_init() and refreshed by every access that covers one of the registers. Functions that report live device state (e.g. mcp7940_status()) always read the device.
+         *
+         * @warning The weekday field and the OSCRUN/PWRFAIL flags in RTCWKDAY are changed by the device itself. Call mcp7940_shadow_invalidate() if another bus master or firmware could have modified the cached registers.
+         *
+         * @note Define `MCP7940_SHADOW_EN` in the project configuration to enable the shadow copies. Leave it undefined (default) to always read the device before modifying a register.
+         */
+        //#define MCP7940_SHADOW_EN
+
+        #ifdef _DOXYGEN_    // Used for documentation, can be ignored
+            #define MCP7940_SHADOW_EN
+        #endif
+    #endif
+
+    #ifndef MCP7940_INIT_FAST
+        /**
+         * @def MCP7940_INIT_FAST
+         * @brief Lets mcp7940_init() skip the reconfiguration of registers that already hold the configured values.
+         *
+         * When this macro is defined, mcp7940_init() reads RTCSEC to OSCTRIM in one burst, computes the values the configuration macros produce for RTCSEC (ST), RTCWKDAY (VBATEN) and CONTROL and only writes the registers that differ. A device that kept its configuration on battery is therefore ready after a single transaction instead of at least six. If the oscillator is stopped, the span of differing registers is written in one burst, otherwise every differing register is written on its own, so that no time register is overwritten with a value that advanced in the meantime.
+         *
+         * @note Define `MCP7940_INIT_FAST` in the project configuration to enable the fast initialization. Leave it undefined (default) to always rewrite the configuration with individual read-modify-write sequences.
+         */
+        //#define MCP7940_INIT_FAST
+
+        #ifdef _DOXYGEN_    // Used for documentation, can be ignored
+            #define MCP7940_INIT_FAST
+        #endif
+    #endif
+
+    #ifndef MCP7940_RECORD_EN
+        /**
+         * @def MCP7940_RECORD_EN
+         * @brief Enables the crash-safe, double-buffered record store in the MCP7940 SRAM.
+         *
+         * When this macro is defined, the driver keeps two alternating slots in the battery-backed SRAM. Each slot holds a sequence number, @c MCP7940_RECORD_SIZE payload bytes and a CRC-8. A commit with mcp7940_record_commit() always overwrites the older slot with one sequential write, so an interrupted commit (e.g. a brown-out) leaves the previous record intact. mcp7940_init() reads both slots in one transaction and selects the newest valid one, which can then be fetched with mcp7940_record_restore().
+         *
+         * @note Define `MCP7940_RECORD_EN` in the project configuration to enable the record store. Leave it undefined (default) if the SRAM is used otherwise.
+         */
+        //#define MCP7940_RECORD_EN
+
+        #ifdef _DOXYGEN_    // Used for documentation, can be ignored
+            #define MCP7940_RECORD_EN
+        #endif
+    #endif
+
+    #ifndef MCP7940_RECORD_SIZE
+        /**
+         * @def MCP7940_RECORD_SIZE
+         * @brief Number of payload bytes of one record in the SRAM record store.
+         *
+         * Each slot occupies @c MCP7940_RECORD_SIZE + 2 bytes (sequence number and CRC-8), and two slots are placed back-to-back starting at @c MCP7940_RECORD_OFFSET.
+         *
+         * @note If MCP7940_RECORD_SIZE is not explicitly defined in the project configuration, it defaults to 28 bytes, which leaves the last 4 SRAM bytes free for other data (e.g. the oscillator calibration).
+         */
+        #define MCP7940_RECORD_SIZE 28
+    #endif
+
+    #ifndef MCP7940_RECORD_OFFSET
+        /**
+         * @def MCP7940_RECORD_OFFSET
+         * @brief SRAM offset of the first slot of the record store.
+         *
+         * @note If MCP7940_RECORD_OFFSET is not explicitly defined in the project configuration, it defaults to 0 (first SRAM byte).
+         */
+        #define MCP7940_RECORD_OFFSET 0
+    #endif
+
+    #ifndef MCP7940_CALIBRATION_EN
+        /**
+         * @def MCP7940_CALIBRATION_EN
+         * @brief Enables the automatic drift measurement and OSCTRIM calibration.
+         *
+         * When this macro is defined, mcp7940_calibration_begin() and mcp7940_calibration_end() measure the deviation of the RTC from a reference clock over a window, convert it to an OSCTRIM value, apply it with mcp7940_trimming() and store it in the battery-backed SRAM at @c MCP7940_CALIBRATION_OFFSET. mcp7940_init() restores the stored value, so a re-calibration is only required occasionally.
+         *
+         * @note Define `MCP7940_CALIBRATION_EN` in the project configuration to enable the calibration. Leave it undefined (default) if the trimming is managed by the application.
+         */
+        //#define MCP7940_CALIBRATION_EN
+
+        #ifdef _DOXYGEN_    // Used for documentation, can be ignored
+            #define MCP7940_CALIBRATION_EN
+        #endif
+    #endif
+
+    #ifndef MCP7940_CALIBRATION_OFFSET
+        /**
+         * @def MCP7940_CALIBRATION_OFFSET
+         * @brief SRAM offset of the stored calibration (OSCTRIM value, coarse flag and CRC-8).
+         *
+         * @note If MCP7940_CALIBRATION_OFFSET is not explicitly defined in the project configuration, it defaults to 60, which is the first byte behind the record store with its default size.
+         */
+        #define MCP7940_CALIBRATION_OFFSET 60
+    #endif
+
+    #ifndef MCP7940_CALIBRATION_POLLS
+        /**
+         * @def MCP7940_CALIBRATION_POLLS
+         * @brief Maximum number of RTCSEC reads while waiting for a seconds edge during a calibration.
+         *
+         * @note If MCP7940_CALIBRATION_POLLS is not explicitly defined in the project configuration, it defaults to 60000, which covers more than one second at a bus clock of 400 kHz.
+         */
+        #define MCP7940_CALIBRATION_POLLS 60000U
+    #endif
+
+    #ifndef MCP7940_MULTI_DEVICE
+        /**
+         * @def MCP7940_MULTI_DEVICE
+         * @brief Enables several MCP7940 devices on one or more TWI/I2C buses.
+         *
+         * When this macro is defined, every ::MCP7940_Device handle carries a pointer to its ::MCP7940_Bus operations and its own TWI/I2C address, which are set up with mcp7940_dev_setup(). If it is not defined, all handles access the bus of @c MCP7940_HAL_PLATFORM directly at @c MCP7940_ADDRESS, and a handle only holds the cached device state, so the singleton API has no additional overhead.
+         *
+         * @note Define `MCP7940_MULTI_DEVICE` in the project configuration if more than one RTC is connected (e.g. redundant RTCs on separate buses). Leave it undefined (default) for a single device.
+         */
+        //#define MCP7940_MULTI_DEVICE
+
+        #ifdef _DOXYGEN_    // Used for documentation, can be ignored
+            #define MCP7940_MULTI_DEVICE
+        #endif
+    #endif
+
+    #ifndef MCP7940_QUEUE_EN
+        /**
+         * @def MCP7940_QUEUE_EN
+         * @brief Enables the request queue that batches several MCP7940 accesses into a minimal number of bus transactions.
+         *
+         * When this macro is defined, reads and writes can be collected with the `mcp7940_queue_*` functions and are executed together by mcp7940_queue_flush(). Reads of adjacent registers (at most @c MCP7940_QUEUE_GAP unused registers apart) are merged into one sequential read, and contiguous writes into one sequential write. All reads are performed before the writes, and the writes are issued in ascending address order.
+         *
+         * @note Define `MCP7940_QUEUE_EN` in the project configuration to enable the request queue. Leave it undefined (default) to save the RAM of the queue in every ::MCP7940_Device.
+         */
+        //#define MCP7940_QUEUE_EN
+
+        #ifdef _DOXYGEN_    // Used for documentation, can be ignored
+            #define MCP7940_QUEUE_EN
+        #endif
+    #endif
+
+    #ifndef MCP7940_QUEUE_SIZE
+        /**
+         * @def MCP7940_QUEUE_SIZE
+         * @brief Maximum number of requests that can be queued per device before mcp7940_queue_flush() has to be called.
+         *
+         * @note If MCP7940_QUEUE_SIZE is not explicitly defined in the project configuration, it defaults to 8 requests.
+         */
+        #define MCP7940_QUEUE_SIZE 8
+    #endif
+
+    #ifndef MCP7940_QUEUE_GAP
+        /**
+         * @def MCP7940_QUEUE_GAP
+         * @brief Maximum number of unrequested registers between two queued reads that are still merged into one sequential read.
+         *
+         * Reading a few unused registers costs less bus time than the start, address and stop overhead of an additional transaction (and the wait configured with @c MCP7940_IO_WAIT). Reading MCP7940 registers has no side effects.
+         *
+         * @note If MCP7940_QUEUE_GAP is not explicitly defined in the project configuration, it defaults to 4 registers.
+         */
+        #define MCP7940_QUEUE_GAP 4
+    #endif
+
+    #ifndef MCP7940_TICK_EN
+        /**
+         * @def MCP7940_TICK_EN
+         * @brief Enables the tick-synchronised clock that serves the current time from RAM.
+         *
+         * When this macro is defined, the driver reads the current date and time once and afterwards advances a local copy on every edge of the 1 Hz square wave on the MFP pin, which has to be signalled with mcp7940_tick_interrupt(). mcp7940_time(), mcp7940_date() and mcp7940_datetime() with `MCP7940_Register_Current_Time` are then served from RAM without bus traffic. The local copy is resynchronised with a burst read every @c MCP7940_TICK_RESYNC seconds. Requires @c MCP7940_MFP_MODE set to @c MCP7940_MFP_MODE_SQUARE_WAVE with @c MCP7940_MFP_SQUARE_WAVE_PRESCALER set to @c MCP7940_SQWFS_1HZ.
+         *
+         * @note Define `MCP7940_TICK_EN` in the project configuration to enable the tick-synchronised clock. Leave it undefined (default) to read the device on every call.
+         */
+        //#define MCP7940_TICK_EN
+
+        #ifdef _DOXYGEN_    // Used for documentation, can be ignored
+            #define MCP7940_TICK_EN
+        #endif
+    #endif
+
+    #ifndef MCP7940_TICK_RESYNC
+        /**
+         * @def MCP7940_TICK_RESYNC
+         * @brief Number of seconds after which the tick-synchronised clock is resynchronised with the device.
+         *
+         * A resync corrects missed MFP interrupts. It is performed by the next time request after the interval elapsed and costs one tear-free burst read.
+         *
+         * @note If MCP7940_TICK_RESYNC is not explicitly defined in the project configuration, it defaults to 3600 seconds (1 hour).
+         */
+        #define MCP7940_TICK_RESYNC 3600U
+    #endif
+
+    #ifdef MCP7940_TICK_EN
+        #ifndef MCP7940_TICK_MS
+            /**
+             * @def MCP7940_TICK_MS
+             * @brief Evaluates to a free-running millisecond counter used for sub-second timestamps.
+             *
+             * When this macro is defined together with @c MCP7940_TICK_EN, mcp7940_tick_interrupt() latches the counter at every 1 Hz MFP edge, and mcp7940_tick_timestamp() interpolates the milliseconds since the last edge. Only differences of the counter are used, so it may wrap around (an `unsigned int` millisecond counter of a systick module is sufficient), e.g. `systick_timer_ms()`.
+             *
+             * @note Map `MCP7940_TICK_MS()` in the project configuration to the millisecond counter of the application. Leave it undefined (default) if no sub-second resolution is required.
+             */
+            //#define MCP7940_TICK_MS() systick_timer_ms()
+
+            #ifdef _DOXYGEN_    // Used for documentation, can be ignored
+                #define MCP7940_TICK_MS() systick_timer_ms()
+            #endif
+        #endif
+    #endif
+
     #ifndef MCP7940_RTCSEC
         /**
          * @def MCP7940_RTCSEC
@@ -256,7 +675,9 @@
         #define MCP7940_RTCHOUR 0x02
 
         #define MCP7940_FORMAT_bm 0x40 /**< Bit mask for the hour format selection bit (12/24-hour mode) in the hours register. */
-        #define MCP7940_HRTEN_bm  0x30 /**< Bit mask for the tens-of-hours BCD field in the hours register. */
+        #define MCP7940_AMPM_bm   0x20 /**< Bit mask for the AM/PM indicator in 12-hour mode (set for PM) in the hours register. */
+        #define MCP7940_HRTEN_bm  0x30 /**< Bit mask for the tens-of-hours BCD field in the hours register (24-hour mode). */
+        #define MCP7940_HRTEN12_bm 0x10 /**< Bit mask for the tens-of-hours BCD field in the hours register (12-hour mode). */
         #define MCP7940_HRTEN_bp  4    /**< Bit position of the least significant bit of the tens-of-hours field. */
     #endif
 
@@ -352,6 +773,102 @@
         #define MCP7940_SIGN_bm 0x80 /**< Bit mask for the SIGN bit indicating the trim direction (positive or negative adjustment). */
     #endif
 
+    /**
+     * @def MCP7940_CALIBRATION_COARSE
+     * @brief Number of fine trim steps that correspond to one coarse trim step (CSTRIM set).
+     *
+     * A fine step adds or subtracts 2 clock cycles once per minute, a coarse step 128 times per second, so one coarse step equals 128 * 60 fine steps.
+     */
+    #define MCP7940_CALIBRATION_COARSE 7680L
+
+    /**
+     * @def MCP7940_RTCC_SIZE
+     * @brief Number of timekeeping registers (RTCSEC to RTCYEAR) transferred in one sequential read or write.
+     */
+    #define MCP7940_RTCC_SIZE 7
+
+    /**
+     * @def MCP7940_TIMESTAMP_SIZE
+     * @brief Number of registers (MIN, HOUR, DATE, MTH) of one power-down or power-up timestamp block.
+     */
+    #define MCP7940_TIMESTAMP_SIZE 4
+
+    /**
+     * @def MCP7940_ISO8601_SIZE
+     * @brief Size of the buffer required by mcp7940_snapshot_iso8601() for `YYYY-MM-DDThh:mm:ss` including the terminating null character.
+     */
+    #define MCP7940_ISO8601_SIZE 20
+
+    #ifndef MCP7940_SRAM
+        /**
+         * @def MCP7940_SRAM
+         * @brief Address of the first byte of the MCP7940 battery-backed SRAM.
+         *
+         * This macro defines the register address of the general-purpose SRAM block (0x20 to 0x5F), which keeps its content as long as VCC or VBAT is present. The sequential address pointer wraps from the last SRAM byte back to this address.
+         */
+        #define MCP7940_SRAM 0x20
+
+        #define MCP7940_SRAM_SIZE 64 /**< Number of bytes in the battery-backed SRAM block. */
+    #endif
+
+    #ifdef MCP7940_HAS_EEPROM
+        #ifndef MCP7940_EEPROM_ADDRESS
+            /**
+             * @def MCP7940_EEPROM_ADDRESS
+             * @brief Defines the TWI/I2C address of the EEPROM of the MCP7941x.
+             *
+             * @note By default, `MCP7940_EEPROM_ADDRESS` is set to `0x57`.
+             */
+            #define MCP7940_EEPROM_ADDRESS 0x57
+        #endif
+
+        #ifndef MCP7940_EEPROM_SIZE
+            /**
+             * @def MCP7940_EEPROM_SIZE
+             * @brief Number of bytes of the general-purpose EEPROM of the MCP7941x (addresses 0x00 to 0x7F).
+             */
+            #define MCP7940_EEPROM_SIZE 128
+
+            #define MCP7940_EEPROM_PAGE 8 /**< Size of one EEPROM write page, a write must not cross a page boundary. */
+        #endif
+
+        #ifndef MCP7940_EUI
+            /**
+             * @def MCP7940_EUI
+             * @brief Address of the protected unique ID area of the MCP7941x EEPROM (0xF0 to 0xF7).
+             *
+             * The pre-programmed EUI-48 (MCP79411) occupies the last 6 bytes and the EUI-64 (MCP79412) all 8 bytes of this area.
+             */
+            #define MCP7940_EUI 0xF0
+
+            #define MCP7940_EUI_AREA 8 /**< Number of bytes in the protected unique ID area. */
+        #endif
+
+        #ifndef MCP7940_EEPROM_POLLS
+            /**
+             * @def MCP7940_EEPROM_POLLS
+             * @brief Maximum number of acknowledge polls while the EEPROM completes a write cycle.
+             *
+             * Instead of a fixed delay, the EEPROM is addressed repeatedly before every access until it acknowledges, which happens as soon as a previous write cycle (at most 5 ms) has finished.
+             *
+             * @note If MCP7940_EEPROM_POLLS is not explicitly defined in the project configuration, it defaults to 500, which covers the maximum write cycle time at a bus clock of 400 kHz.
+             */
+            #define MCP7940_EEPROM_POLLS 500U
+        #endif
+    #endif
+
+    /**
+     * @def MCP7940_EPOCH_OFFSET
+     * @brief Seconds between the Unix epoch (01.01.1970) and 01.01.2000, the date the RTC year 00 corresponds to.
+     */
+    #define MCP7940_EPOCH_OFFSET 946684800UL
+
+    /**
+     * @def MCP7940_EPOCH_LIMIT
+     * @brief First Unix time (01.01.2100) that can no longer be represented by the two-digit RTC year.
+     */
+    #define MCP7940_EPOCH_LIMIT 4102444800UL
+
     // #############################################
 
     #ifndef MCP7940_WEEKDAY_bp
@@ -617,12 +1134,15 @@
      * @brief Represents error conditions reported by the MCP7940 driver.
      *
      * @details
-     * This enumeration defines generic error codes used by the MCP7940 access routines. It currently distinguishes between the absence of an error and a generic failure condition, which may cover I2C communication issues, invalid parameters, or unexpected device responses. Additional error codes can be added as the driver implementation is extended.
+     * This enumeration defines the error codes used by the MCP7940 access routines. Besides the absence of an error and a generic failure condition (invalid parameters or unexpected device responses), TWI/I2C failures are reported with distinct codes, so the application can decide whether to retry or reschedule an access. The bus codes are derived from the HAL status with @c MCP7940_TWI_ERROR.
      */
     enum MCP7940_Error_t
     {
-        MCP7940_Error_None = 0, /**< No error occurred, operation completed successfully */
-        MCP7940_Error_Fail      /**< A generic failure occurred during an MCP7940 operation */
+        MCP7940_Error_None = 0,     /**< No error occurred, operation completed successfully */
+        MCP7940_Error_Fail,         /**< A generic failure occurred during an MCP7940 operation */
+        MCP7940_Error_Nack,         /**< The device did not acknowledge its address or a data byte */
+        MCP7940_Error_Timeout,      /**< The bus or the device did not become ready within the configured poll limit */
+        MCP7940_Error_Arbitration   /**< The arbitration was lost to another bus master */
     };
     /**
      * @typedef MCP7940_Error
@@ -630,6 +1150,64 @@
      */
     typedef enum MCP7940_Error_t MCP7940_Error;
 
+    /**
+     * @enum MCP7940_Trace_t
+     * @brief Identifies the driver operation passed to the trace hooks @c MCP7940_TRACE_BEGIN and @c MCP7940_TRACE_END.
+     *
+     * @details
+     * Besides the public entry points, the single bus transaction (including its retries and the wait afterwards) and the wait after a transaction are reported, so a profiler can attribute bus and delay time to the calling function. The values of optional functions are defined independently of the configuration, so the numbering does not change with the feature set.
+     */
+    enum MCP7940_Trace_t
+    {
+        MCP7940_Trace_Transfer = 0,         /**< One TWI/I2C transaction with the RTCC/SRAM including retries */
+        MCP7940_Trace_Wait,                 /**< Wait after a transaction (see @c MCP7940_IO_WAIT) */
+        MCP7940_Trace_Battery,              /**< Battery backup configuration during mcp7940_init() */
+        MCP7940_Trace_Init,                 /**< mcp7940_init() */
+        MCP7940_Trace_Trimming,             /**< mcp7940_trimming() */
+        MCP7940_Trace_Oscillator,           /**< mcp7940_oscillator() */
+        MCP7940_Trace_Status,               /**< mcp7940_status() */
+        MCP7940_Trace_Mfp_Output,           /**< mcp7940_mfp_output() */
+        MCP7940_Trace_Weekday,              /**< mcp7940_weekday() */
+        MCP7940_Trace_Time,                 /**< mcp7940_time() */
+        MCP7940_Trace_Date,                 /**< mcp7940_date() */
+        MCP7940_Trace_Datetime,             /**< mcp7940_datetime() */
+        MCP7940_Trace_Datetime_Atomic,      /**< mcp7940_datetime_atomic() */
+        MCP7940_Trace_Leapyear,             /**< mcp7940_leapyear() */
+        MCP7940_Trace_Snapshot,             /**< mcp7940_snapshot() */
+        MCP7940_Trace_Setweekday,           /**< mcp7940_setweekday() */
+        MCP7940_Trace_Settime,              /**< mcp7940_settime() */
+        MCP7940_Trace_Setdate,              /**< mcp7940_setdate() */
+        MCP7940_Trace_Setdatetime,          /**< mcp7940_setdatetime() */
+        MCP7940_Trace_Epoch,                /**< mcp7940_epoch() */
+        MCP7940_Trace_Setepoch,             /**< mcp7940_setepoch() */
+        MCP7940_Trace_Powerfail_Read,       /**< mcp7940_powerfail_read() */
+        MCP7940_Trace_Alarm_Set,            /**< mcp7940_alarm_set() */
+        MCP7940_Trace_Alarm_Get,            /**< mcp7940_alarm_get() */
+        MCP7940_Trace_Alarm_Enable,         /**< mcp7940_alarm_enable() */
+        MCP7940_Trace_Alarm_Clear,          /**< mcp7940_alarm_clear() */
+        MCP7940_Trace_Alarm_Pending,        /**< mcp7940_alarm_pending() */
+        MCP7940_Trace_Sram_Read,            /**< mcp7940_sram_read() */
+        MCP7940_Trace_Sram_Write,           /**< mcp7940_sram_write() */
+        MCP7940_Trace_Eeprom_Read,          /**< mcp7940_eeprom_read() */
+        MCP7940_Trace_Eeprom_Write,         /**< mcp7940_eeprom_write() */
+        MCP7940_Trace_Eui_Read,             /**< mcp7940_eui_read() */
+        MCP7940_Trace_Record_Commit,        /**< mcp7940_record_commit() */
+        MCP7940_Trace_Record_Restore,       /**< mcp7940_record_restore() */
+        MCP7940_Trace_Calibration_Begin,    /**< mcp7940_calibration_begin() */
+        MCP7940_Trace_Calibration_End,      /**< mcp7940_calibration_end() */
+        MCP7940_Trace_Calibration_Restore,  /**< mcp7940_calibration_restore() */
+        MCP7940_Trace_Tick_Sync,            /**< mcp7940_tick_sync() */
+        MCP7940_Trace_Tick_Timestamp,       /**< mcp7940_tick_timestamp() */
+        MCP7940_Trace_Queue_Flush,          /**< mcp7940_queue_flush() */
+        MCP7940_Trace_Oscillator_Start,     /**< mcp7940_oscillator_start() */
+        MCP7940_Trace_Snapshot_Atomic       /**< mcp7940_snapshot_atomic() */
+    };
+    /**
+     * @typedef MCP7940_Trace
+     * @brief Alias for enum MCP7940_Trace_t representing a traced MCP7940 driver operation.
+     */
+    typedef enum MCP7940_Trace_t MCP7940_Trace;
+
     /**
      * @enum MCP7940_Mode_t
      * @brief Selects enabled or disabled mode for MCP7940 features.
@@ -666,6 +1244,65 @@
      */
     typedef enum MCP7940_Trim_t MCP7940_Trim;
 
+    /**
+     * @enum MCP7940_Alarm_t
+     * @brief Selects one of the two hardware alarms of the MCP7940.
+     *
+     * @details
+     * The MCP7940 provides two independent alarm modules (ALM0 and ALM1), each with its own register block and interrupt flag. Alarm 0 uses the polarity @c MCP7940_MFP_ALARM1_POLARITY and Alarm 1 the polarity @c MCP7940_MFP_ALARM2_POLARITY.
+     */
+    enum MCP7940_Alarm_t
+    {
+        MCP7940_Alarm_0 = 0, /**< Alarm module 0 (ALM0SEC to ALM0MTH) */
+        MCP7940_Alarm_1      /**< Alarm module 1 (ALM1SEC to ALM1MTH) */
+    };
+    /**
+     * @typedef MCP7940_Alarm
+     * @brief Alias for enum MCP7940_Alarm_t representing an MCP7940 alarm module.
+     */
+    typedef enum MCP7940_Alarm_t MCP7940_Alarm;
+
+    /**
+     * @enum MCP7940_Match_t
+     * @brief Selects the alarm match condition of an MCP7940 alarm module.
+     *
+     * @details
+     * The values correspond to the ALMMSK field in the ALMxWKDAY register and define which fields of the alarm registers are compared against the current time to trigger an alarm.
+     */
+    enum MCP7940_Match_t
+    {
+        MCP7940_Match_Second = MCP7940_ALARM_SECOND_MATCH_gc, /**< Match on seconds */
+        MCP7940_Match_Minute = MCP7940_ALARM_MINUTE_MATCH,    /**< Match on minutes */
+        MCP7940_Match_Hour   = MCP7940_ALARM_HOUR_MATCH,      /**< Match on hours */
+        MCP7940_Match_Day    = MCP7940_ALARM_DAY_MATCH,       /**< Match on the weekday */
+        MCP7940_Match_Date   = MCP7940_ALARM_DATE_MATCH,      /**< Match on the date (day of month) */
+        MCP7940_Match_Full   = MCP7940_ALARM_FULL_MATCH       /**< Match on seconds, minutes, hours, weekday, date and month */
+    };
+    /**
+     * @typedef MCP7940_Match
+     * @brief Alias for enum MCP7940_Match_t representing an MCP7940 alarm match condition.
+     */
+    typedef enum MCP7940_Match_t MCP7940_Match;
+
+    /**
+     * @enum MCP7940_Wait_t
+     * @brief Selects the runtime wait strategy after each MCP7940 bus transaction.
+     *
+     * @details
+     * This enumeration is only used when @c MCP7940_IO_WAIT is set to @c MCP7940_IO_WAIT_RUNTIME and allows switching between the fixed delay, polling of the TWI bus state, and no wait at all without recompiling the driver.
+     */
+    enum MCP7940_Wait_t
+    {
+        MCP7940_Wait_Delay = 0, /**< Block for MCP7940_IO_TIMEOUT_MS after each transaction */
+        MCP7940_Wait_Poll,      /**< Poll MCP7940_TWI_BUSY until the bus is idle (bounded by MCP7940_IO_POLL_LIMIT) */
+        MCP7940_Wait_None       /**< Do not wait after a transaction */
+    };
+    /**
+     * @typedef MCP7940_Wait
+     * @brief Alias for enum MCP7940_Wait_t representing the MCP7940 runtime wait strategy.
+     */
+    typedef enum MCP7940_Wait_t MCP7940_Wait;
+
     /**
      * @enum MCP7940_LeapYear_t
      * @brief Indicates whether the MCP7940 calendar year is a leap year.
@@ -694,8 +1331,10 @@
     enum MCP7940_Register_t
     {
         MCP7940_Register_Current_Time   = 0, /**< Current time and calendar register block */
+    #ifdef MCP7940_HAS_BATTERY
         MCP7940_Register_Power_Down_Time,    /**< Power-down time-stamp register block*/
         MCP7940_Register_Power_Up_Time       /**< Power-up time-stamp register block */
+    #endif
     };
 
     /**
@@ -704,28 +1343,466 @@
      */
     typedef enum MCP7940_Register_t MCP7940_Register;
 
+    #ifdef MCP7940_MULTI_DEVICE
+        /**
+         * @struct MCP7940_Bus_t
+         * @brief Bus operations used to access an MCP7940 device.
+         *
+         * @details
+         * This structure abstracts the TWI/I2C primitives of one bus, so that several MCP7940 devices on different buses can be driven by the same driver code. The functions have the same semantics as the ones of the TWI hardware abstraction layer (see ::mcp7940_twi) and report their result as ::MCP7940_Error (`MCP7940_Error_None` on success).
+         */
+        struct MCP7940_Bus_t
+        {
+            MCP7940_Error (*start)(void);                                               /**< Generates a start condition */
+            MCP7940_Error (*address)(unsigned char address, unsigned char operation);   /**< Sends the 7-bit address with TWI_WRITE or TWI_READ (a repeated start is generated if the bus is already owned) */
+            MCP7940_Error (*set)(unsigned char data);                                   /**< Transmits one data byte */
+            MCP7940_Error (*get)(unsigned char *data, unsigned char acknowledge);       /**< Receives one data byte and answers with TWI_ACK or TWI_NACK */
+            void (*stop)(void);                                                         /**< Generates a stop condition */
+            unsigned char (*busy)(void);                                                /**< Returns non-zero while the bus has not yet returned to the idle state (may be 0 if every transfer completes before returning) */
+        };
+        /**
+         * @typedef MCP7940_Bus
+         * @brief Alias for struct MCP7940_Bus_t representing the bus operations of an MCP7940 device.
+         */
+        typedef struct MCP7940_Bus_t MCP7940_Bus;
+    #endif
+
+    #ifdef MCP7940_QUEUE_EN
+        /**
+         * @struct MCP7940_Request_t
+         * @brief One request of the MCP7940 request queue.
+         *
+         * @details
+         * The members are managed by the `mcp7940_queue_*` functions and should not be accessed directly.
+         */
+        struct MCP7940_Request_t
+        {
+            unsigned char type;     /**< Kind of request (raw read, raw write, status or datetime) */
+            unsigned char address;  /**< First register address */
+            unsigned char length;   /**< Number of registers */
+            void *data;             /**< Destination (reads) or source (writes) of the request */
+        };
+        /**
+         * @typedef MCP7940_Request
+         * @brief Alias for struct MCP7940_Request_t representing one queued MCP7940 request.
+         */
+        typedef struct MCP7940_Request_t MCP7940_Request;
+    #endif
 
-                 void mcp7940_init(void);
-        MCP7940_Error mcp7940_trimming(MCP7940_Trim mode, unsigned char value);
-                 void mcp7940_oscillator(MCP7940_Mode mode);
-       MCP7940_Status mcp7940_status(void);
+    #ifdef MCP7940_HAS_BATTERY
+        /**
+         * @struct MCP7940_PowerFail_t
+         * @brief Power-fail event of the MCP7940 as returned by mcp7940_powerfail_read().
+         *
+         * @details
+         * The timestamps have a resolution of one minute, so the seconds are always 0. The year is not stored by the device and is inferred from the current date.
+         */
+        struct MCP7940_PowerFail_t
+        {
+            FORMAT_DateTime down;       /**< Time at which the main supply failed */
+            FORMAT_DateTime up;         /**< Time at which the main supply was restored */
+            unsigned long duration;     /**< Duration of the outage in seconds */
+        };
+        /**
+         * @typedef MCP7940_PowerFail
+         * @brief Alias for struct MCP7940_PowerFail_t representing an MCP7940 power-fail event.
+         */
+        typedef struct MCP7940_PowerFail_t MCP7940_PowerFail;
+    #endif
+
+    /**
+     * @struct MCP7940_Snapshot_t
+     * @brief Raw copy of the MCP7940 registers RTCSEC to OSCTRIM as read by mcp7940_snapshot().
+     *
+     * @details
+     * The registers are stored unmodified in one sequential block (index = register address), so status and calendar queries can be answered from a single bus read with the `mcp7940_snapshot_*` accessors.
+     */
+    struct MCP7940_Snapshot_t
+    {
+        unsigned char data[MCP7940_OSCTRIM + 1];    /**< Register values of RTCSEC to OSCTRIM */
+    };
+    /**
+     * @typedef MCP7940_Snapshot
+     * @brief Alias for struct MCP7940_Snapshot_t representing a raw MCP7940 register snapshot.
+     */
+    typedef struct MCP7940_Snapshot_t MCP7940_Snapshot;
+
+    /**
+     * @brief Returns the leap-year flag (LPYR) of a register snapshot.
+     *
+     * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+     *
+     * @return `MCP7940_LeapYear_True` if the current year is a leap year, otherwise `MCP7940_LeapYear_False`.
+     */
+    static inline MCP7940_LeapYear mcp7940_snapshot_leapyear(const MCP7940_Snapshot *snapshot)
+    {
+        return (MCP7940_LeapYear)((MCP7940_LPYR_bm & snapshot->data[MCP7940_RTCMTH]) >> MCP7940_LPYR_bp);
+    }
+
+    /**
+     * @brief Returns the status flags (OSCRUN, PWRFAIL, VBATEN) of a register snapshot as ::MCP7940_Status, equivalent to mcp7940_status().
+     *
+     * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+     *
+     * @return Combination of ::MCP7940_Status flags.
+     */
+    static inline MCP7940_Status mcp7940_snapshot_status(const MCP7940_Snapshot *snapshot)
+    {
+        return (MCP7940_Status)(snapshot->data[MCP7940_RTCWKDAY] & (MCP7940_OSCRUN_bm | MCP7940_PWRFAIL_bm | MCP7940_VBATEN_bm));
+    }
+
+    /**
+     * @brief Returns whether the oscillator was running (OSCRUN) when the snapshot was taken.
+     *
+     * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+     *
+     * @return Non-zero if OSCRUN is set, otherwise 0.
+     */
+    static inline unsigned char mcp7940_snapshot_running(const MCP7940_Snapshot *snapshot)
+    {
+        return (snapshot->data[MCP7940_RTCWKDAY] & MCP7940_OSCRUN_bm);
+    }
+
+    #ifdef MCP7940_HAS_BATTERY
+    /**
+     * @brief Returns whether a power failure has been recorded (PWRFAIL) in a register snapshot.
+     *
+     * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+     *
+     * @return Non-zero if PWRFAIL is set, otherwise 0.
+     */
+    static inline unsigned char mcp7940_snapshot_powerfail(const MCP7940_Snapshot *snapshot)
+    {
+        return (snapshot->data[MCP7940_RTCWKDAY] & MCP7940_PWRFAIL_bm);
+    }
+
+    /**
+     * @brief Returns whether battery backup is enabled (VBATEN) in a register snapshot.
+     *
+     * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+     *
+     * @return Non-zero if VBATEN is set, otherwise 0.
+     */
+    static inline unsigned char mcp7940_snapshot_battery(const MCP7940_Snapshot *snapshot)
+    {
+        return (snapshot->data[MCP7940_RTCWKDAY] & MCP7940_VBATEN_bm);
+    }
+    #endif
+
+    /**
+     * @brief Returns whether the hours register of a snapshot is in 12-hour format.
+     *
+     * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+     *
+     * @return Non-zero if the 12/24-hour format bit is set (12-hour mode), otherwise 0 (24-hour mode).
+     */
+    static inline unsigned char mcp7940_snapshot_hour12(const MCP7940_Snapshot *snapshot)
+    {
+        return (snapshot->data[MCP7940_RTCHOUR] & MCP7940_FORMAT_bm);
+    }
+
+    /**
+     * @brief Returns the weekday (1 to 7) of a register snapshot, equivalent to mcp7940_weekday().
+     *
+     * @param snapshot Pointer to a ::MCP7940_Snapshot filled by mcp7940_snapshot().
+     *
+     * @return Weekday value of the RTCWKDAY register.
+     */
+    static inline unsigned char mcp7940_snapshot_weekday(const MCP7940_Snapshot *snapshot)
+    {
+        return (snapshot->data[MCP7940_RTCWKDAY] & 0x07);
+    }
+
+    /**
+     * @struct MCP7940_Device_t
+     * @brief Handle of one MCP7940 device holding its bus access and cached state.
+     *
+     * @details
+     * Every public `mcp7940_dev_*` function operates on such a handle. The members are managed by the driver and should not be modified directly. The singleton API (mcp7940_init(), mcp7940_datetime(), ...) is a set of macros that pass the default handle @c mcp7940_device.
+     */
+    struct MCP7940_Device_t
+    {
+        #ifdef MCP7940_MULTI_DEVICE
+            const MCP7940_Bus *bus;                             /**< Bus operations the device is connected to */
+            unsigned char address;                              /**< 7-bit TWI/I2C address of the device */
+        #endif
+
+        #if MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME
+            MCP7940_Wait wait;                                  /**< Wait strategy selected with mcp7940_dev_waitmode() */
+        #endif
+
+        #ifdef MCP7940_SHADOW_EN
+            unsigned char shadow[3];                            /**< Shadow copies of RTCWKDAY, CONTROL and OSCTRIM */
+            unsigned char shadow_valid;                         /**< Bit mask of the valid shadow copies */
+        #endif
+
+        #ifdef MCP7940_RECORD_EN
+            unsigned char record_slot;                          /**< SRAM slot holding the current record, 0xFF if none */
+            unsigned char record_sequence;                      /**< Sequence number of the current record */
+            unsigned char record_data[MCP7940_RECORD_SIZE];     /**< RAM copy of the current record payload */
+        #endif
+
+        #ifdef MCP7940_QUEUE_EN
+            MCP7940_Request queue[MCP7940_QUEUE_SIZE];          /**< Queued requests sorted by address */
+            unsigned char queue_length;                         /**< Number of queued requests */
+        #endif
+
+        #ifdef MCP7940_CALIBRATION_EN
+            unsigned long calibration_epoch;                    /**< Unix time at the start of the window, 0 if no window is open */
+            unsigned long calibration_reference;                /**< Reference time in milliseconds at the start of the window */
+        #endif
+
+        #ifdef MCP7940_TICK_EN
+            unsigned long tick_epoch;                           /**< Unix time of the local copy at tick_base */
+            unsigned int tick_age;                              /**< Seconds since the last resync */
+            unsigned char tick_base;                            /**< Value of tick_count the local copy corresponds to */
+            volatile unsigned char tick_count;                  /**< Number of MFP edges, incremented by mcp7940_dev_tick_interrupt() */
+            unsigned char tick_valid;                           /**< Non-zero if the local copy has been synchronised */
+            volatile unsigned char tick_wrap;                   /**< Set by mcp7940_dev_tick_interrupt() if tick_count wrapped around tick_base, forces a resync */
+
+            #ifdef MCP7940_TICK_MS
+                volatile unsigned int tick_ms;                  /**< Millisecond counter latched at the last MFP edge */
+            #endif
+        #endif
+        unsigned char alarm_wkday[2];                           /**< Last written ALMxWKDAY values, 0 if unknown */
+    };
+    /**
+     * @typedef MCP7940_Device
+     * @brief Alias for struct MCP7940_Device_t representing an MCP7940 device handle.
+     */
+    typedef struct MCP7940_Device_t MCP7940_Device;
+
+    extern MCP7940_Device mcp7940_device;
+
+    #ifdef MCP7940_ASYNC_EN
+        /**
+         * @typedef MCP7940_Async_Callback
+         * @brief Function that is called by mcp7940_async_poll() when an asynchronous transfer has completed.
+         *
+         * @param error Result of the transfer as ::MCP7940_Error.
+         */
+        typedef void (*MCP7940_Async_Callback)(MCP7940_Error error);
+    #endif
+
+    #ifdef MCP7940_CALIBRATION_EN
+        /**
+         * @typedef MCP7940_Reference
+         * @brief Function that returns the time of the reference clock in milliseconds (e.g. derived from a GPS PPS signal or the host time).
+         *
+         * @return Reference time in milliseconds. Only differences are used, so the counter may start at any value.
+         */
+        typedef unsigned long (*MCP7940_Reference)(void);
+    #endif
+
+    #ifdef MCP7940_MULTI_DEVICE
+        extern const MCP7940_Bus mcp7940_twi;
+    #endif
+
+
+    #ifdef MCP7940_MULTI_DEVICE
+                 void mcp7940_dev_setup(MCP7940_Device *device, const MCP7940_Bus *bus, unsigned char address);
+    #endif
+
+        MCP7940_Error mcp7940_dev_init(MCP7940_Device *device);
+
+    #ifdef MCP7940_SHADOW_EN
+                 void mcp7940_dev_shadow_invalidate(MCP7940_Device *device);
+    #endif
+
+    #if MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME
+                 void mcp7940_dev_waitmode(MCP7940_Device *device, MCP7940_Wait mode);
+    #endif
+
+        MCP7940_Error mcp7940_dev_trimming(MCP7940_Device *device, MCP7940_Trim mode, unsigned char value);
+        MCP7940_Error mcp7940_dev_oscillator(MCP7940_Device *device, MCP7940_Mode mode);
+        MCP7940_Error mcp7940_dev_oscillator_start(MCP7940_Device *device, unsigned int timeout, unsigned int *elapsed);
+       MCP7940_Status mcp7940_dev_status(MCP7940_Device *device);
 
     #if MCP7940_MFP_MODE == MCP7940_MFP_MODE_OUTPUT
-                 void mcp7940_mfp_output(MCP7940_Mode output);
+        MCP7940_Error mcp7940_dev_mfp_output(MCP7940_Device *device, MCP7940_Mode output);
     #endif
 
           const char* mcp7940_weekday_string(unsigned char day);
-        unsigned char mcp7940_weekday(MCP7940_Register data);
+        unsigned char mcp7940_dev_weekday(MCP7940_Device *device, MCP7940_Register data);
     
-                 void mcp7940_time(FORMAT_Time *time, MCP7940_Register reg);
-                 void mcp7940_date(FORMAT_Date *date, MCP7940_Register reg);
-                 void mcp7940_datetime(FORMAT_DateTime *datetime, MCP7940_Register reg);
+        MCP7940_Error mcp7940_dev_time(MCP7940_Device *device, FORMAT_Time *time, MCP7940_Register reg);
+        MCP7940_Error mcp7940_dev_date(MCP7940_Device *device, FORMAT_Date *date, MCP7940_Register reg);
+        MCP7940_Error mcp7940_dev_datetime(MCP7940_Device *device, FORMAT_DateTime *datetime, MCP7940_Register reg);
+        MCP7940_Error mcp7940_dev_datetime_atomic(MCP7940_Device *device, FORMAT_DateTime *datetime);
 
-     MCP7940_LeapYear mcp7940_leapyear(void);
+     MCP7940_LeapYear mcp7940_dev_leapyear(MCP7940_Device *device);
 
-        MCP7940_Error mcp7940_setweekday(unsigned char weekday);
-        MCP7940_Error mcp7940_settime(const FORMAT_Time *time);
-        MCP7940_Error mcp7940_setdate(const FORMAT_Date *date);
-        MCP7940_Error mcp7940_setdatetime(const FORMAT_DateTime *datetime);
+        MCP7940_Error mcp7940_dev_snapshot(MCP7940_Device *device, MCP7940_Snapshot *snapshot);
+        MCP7940_Error mcp7940_dev_snapshot_atomic(MCP7940_Device *device, MCP7940_Snapshot *snapshot);
+                 void mcp7940_snapshot_datetime(const MCP7940_Snapshot *snapshot, FORMAT_DateTime *datetime);
+          const char* mcp7940_snapshot_weekday_string(const MCP7940_Snapshot *snapshot);
+                char* mcp7940_snapshot_iso8601(const MCP7940_Snapshot *snapshot, char *buffer);
+
+        MCP7940_Error mcp7940_dev_setweekday(MCP7940_Device *device, unsigned char weekday);
+        MCP7940_Error mcp7940_dev_settime(MCP7940_Device *device, const FORMAT_Time *time);
+        MCP7940_Error mcp7940_dev_setdate(MCP7940_Device *device, const FORMAT_Date *date);
+        MCP7940_Error mcp7940_dev_setdatetime(MCP7940_Device *device, const FORMAT_DateTime *datetime);
+
+        MCP7940_Error mcp7940_dev_epoch(MCP7940_Device *device, unsigned long *epoch);
+        MCP7940_Error mcp7940_dev_setepoch(MCP7940_Device *device, unsigned long epoch);
+
+    #ifdef MCP7940_HAS_BATTERY
+        MCP7940_Error mcp7940_dev_powerfail_read(MCP7940_Device *device, MCP7940_PowerFail *powerfail);
+    #endif
+
+        MCP7940_Error mcp7940_dev_alarm_set(MCP7940_Device *device, MCP7940_Alarm alarm, const FORMAT_DateTime *datetime, unsigned char weekday, MCP7940_Match match);
+        MCP7940_Error mcp7940_dev_alarm_get(MCP7940_Device *device, MCP7940_Alarm alarm, FORMAT_DateTime *datetime, unsigned char *weekday, MCP7940_Match *match);
+        MCP7940_Error mcp7940_dev_alarm_enable(MCP7940_Device *device, MCP7940_Alarm alarm, MCP7940_Mode mode);
+        MCP7940_Error mcp7940_dev_alarm_clear(MCP7940_Device *device, MCP7940_Alarm alarm);
+        unsigned char mcp7940_dev_alarm_pending(MCP7940_Device *device, MCP7940_Alarm alarm);
+
+        MCP7940_Error mcp7940_dev_sram_read(MCP7940_Device *device, unsigned char offset, unsigned char *data, unsigned char length);
+        MCP7940_Error mcp7940_dev_sram_write(MCP7940_Device *device, unsigned char offset, const unsigned char *data, unsigned char length);
+
+    #ifdef MCP7940_HAS_EEPROM
+        MCP7940_Error mcp7940_dev_eeprom_read(MCP7940_Device *device, unsigned char address, unsigned char *data, unsigned char length);
+        MCP7940_Error mcp7940_dev_eeprom_write(MCP7940_Device *device, unsigned char address, const unsigned char *data, unsigned char length);
+    #endif
+
+    #ifdef MCP7940_HAS_EUI
+        MCP7940_Error mcp7940_dev_eui_read(MCP7940_Device *device, unsigned char *eui);
+    #endif
+
+    #ifdef MCP7940_RECORD_EN
+        MCP7940_Error mcp7940_dev_record_commit(MCP7940_Device *device, const unsigned char *data);
+        MCP7940_Error mcp7940_dev_record_restore(MCP7940_Device *device, unsigned char *data);
+    #endif
+
+    #ifdef MCP7940_CALIBRATION_EN
+        MCP7940_Error mcp7940_dev_calibration_begin(MCP7940_Device *device, MCP7940_Reference reference);
+        MCP7940_Error mcp7940_dev_calibration_end(MCP7940_Device *device, MCP7940_Reference reference, long *ppm);
+        MCP7940_Error mcp7940_dev_calibration_restore(MCP7940_Device *device);
+    #endif
+
+    #ifdef MCP7940_QUEUE_EN
+        MCP7940_Error mcp7940_dev_queue_read(MCP7940_Device *device, unsigned char address, unsigned char *data, unsigned char length);
+        MCP7940_Error mcp7940_dev_queue_write(MCP7940_Device *device, unsigned char address, const unsigned char *data, unsigned char length);
+        MCP7940_Error mcp7940_dev_queue_status(MCP7940_Device *device, MCP7940_Status *status);
+        MCP7940_Error mcp7940_dev_queue_datetime(MCP7940_Device *device, FORMAT_DateTime *datetime);
+        MCP7940_Error mcp7940_dev_queue_flush(MCP7940_Device *device, unsigned char *transactions);
+    #endif
+
+    #ifdef MCP7940_TICK_EN
+        MCP7940_Error mcp7940_dev_tick_sync(MCP7940_Device *device);
+                 void mcp7940_dev_tick_interrupt(MCP7940_Device *device);
+
+        #ifdef MCP7940_TICK_MS
+        MCP7940_Error mcp7940_dev_tick_timestamp(MCP7940_Device *device, FORMAT_DateTime *datetime, unsigned int *millisecond);
+        #endif
+    #endif
+
+    #ifdef MCP7940_ASYNC_EN
+        MCP7940_Error mcp7940_dev_datetime_async(MCP7940_Device *device, FORMAT_DateTime *datetime, MCP7940_Async_Callback callback);
+        MCP7940_Error mcp7940_dev_settime_async(MCP7940_Device *device, const FORMAT_Time *time, MCP7940_Async_Callback callback);
+        MCP7940_Error mcp7940_dev_setdate_async(MCP7940_Device *device, const FORMAT_Date *date, MCP7940_Async_Callback callback);
+        MCP7940_Error mcp7940_dev_sram_read_async(MCP7940_Device *device, unsigned char offset, unsigned char *data, unsigned char length, MCP7940_Async_Callback callback);
+        MCP7940_Error mcp7940_dev_sram_write_async(MCP7940_Device *device, unsigned char offset, const unsigned char *data, unsigned char length, MCP7940_Async_Callback callback);
+
+        unsigned char mcp7940_async_busy(void);
+                 void mcp7940_async_poll(void);
+    #endif
+
+    // Singleton API operating on the default device
+    #define mcp7940_init()                                      mcp7940_dev_init(&mcp7940_device)
+
+    #ifdef MCP7940_SHADOW_EN
+        #define mcp7940_shadow_invalidate()                     mcp7940_dev_shadow_invalidate(&mcp7940_device)
+    #endif
+
+    #if MCP7940_IO_WAIT == MCP7940_IO_WAIT_RUNTIME
+        #define mcp7940_waitmode(mode)                          mcp7940_dev_waitmode(&mcp7940_device, (mode))
+    #endif
+
+    #define mcp7940_trimming(mode, value)                       mcp7940_dev_trimming(&mcp7940_device, (mode), (value))
+    #define mcp7940_oscillator(mode)                            mcp7940_dev_oscillator(&mcp7940_device, (mode))
+    #define mcp7940_oscillator_start(timeout, elapsed)          mcp7940_dev_oscillator_start(&mcp7940_device, (timeout), (elapsed))
+    #define mcp7940_status()                                    mcp7940_dev_status(&mcp7940_device)
+
+    #if MCP7940_MFP_MODE == MCP7940_MFP_MODE_OUTPUT
+        #define mcp7940_mfp_output(output)                      mcp7940_dev_mfp_output(&mcp7940_device, (output))
+    #endif
+
+    #define mcp7940_weekday(data)                               mcp7940_dev_weekday(&mcp7940_device, (data))
+
+    #define mcp7940_time(time, reg)                             mcp7940_dev_time(&mcp7940_device, (time), (reg))
+    #define mcp7940_date(date, reg)                             mcp7940_dev_date(&mcp7940_device, (date), (reg))
+    #define mcp7940_datetime(datetime, reg)                     mcp7940_dev_datetime(&mcp7940_device, (datetime), (reg))
+    #define mcp7940_datetime_atomic(datetime)                   mcp7940_dev_datetime_atomic(&mcp7940_device, (datetime))
+
+    #define mcp7940_leapyear()                                  mcp7940_dev_leapyear(&mcp7940_device)
+
+    #define mcp7940_snapshot(snapshot)                          mcp7940_dev_snapshot(&mcp7940_device, (snapshot))
+    #define mcp7940_snapshot_atomic(snapshot)                   mcp7940_dev_snapshot_atomic(&mcp7940_device, (snapshot))
+
+    #define mcp7940_setweekday(weekday)                         mcp7940_dev_setweekday(&mcp7940_device, (weekday))
+    #define mcp7940_settime(time)                               mcp7940_dev_settime(&mcp7940_device, (time))
+    #define mcp7940_setdate(date)                               mcp7940_dev_setdate(&mcp7940_device, (date))
+    #define mcp7940_setdatetime(datetime)                       mcp7940_dev_setdatetime(&mcp7940_device, (datetime))
+
+    #define mcp7940_epoch(epoch)                                mcp7940_dev_epoch(&mcp7940_device, (epoch))
+    #define mcp7940_setepoch(epoch)                             mcp7940_dev_setepoch(&mcp7940_device, (epoch))
+
+    #ifdef MCP7940_HAS_BATTERY
+        #define mcp7940_powerfail_read(powerfail)               mcp7940_dev_powerfail_read(&mcp7940_device, (powerfail))
+    #endif
+
+    #define mcp7940_alarm_set(alarm, datetime, weekday, match)  mcp7940_dev_alarm_set(&mcp7940_device, (alarm), (datetime), (weekday), (match))
+    #define mcp7940_alarm_get(alarm, datetime, weekday, match)  mcp7940_dev_alarm_get(&mcp7940_device, (alarm), (datetime), (weekday), (match))
+    #define mcp7940_alarm_enable(alarm, mode)                   mcp7940_dev_alarm_enable(&mcp7940_device, (alarm), (mode))
+    #define mcp7940_alarm_clear(alarm)                          mcp7940_dev_alarm_clear(&mcp7940_device, (alarm))
+    #define mcp7940_alarm_pending(alarm)                        mcp7940_dev_alarm_pending(&mcp7940_device, (alarm))
+
+    #define mcp7940_sram_read(offset, data, length)             mcp7940_dev_sram_read(&mcp7940_device, (offset), (data), (length))
+    #define mcp7940_sram_write(offset, data, length)            mcp7940_dev_sram_write(&mcp7940_device, (offset), (data), (length))
+
+    #ifdef MCP7940_HAS_EEPROM
+        #define mcp7940_eeprom_read(address, data, length)      mcp7940_dev_eeprom_read(&mcp7940_device, (address), (data), (length))
+        #define mcp7940_eeprom_write(address, data, length)     mcp7940_dev_eeprom_write(&mcp7940_device, (address), (data), (length))
+    #endif
+
+    #ifdef MCP7940_HAS_EUI
+        #define mcp7940_eui_read(eui)                           mcp7940_dev_eui_read(&mcp7940_device, (eui))
+    #endif
+
+    #ifdef MCP7940_RECORD_EN
+        #define mcp7940_record_commit(data)                     mcp7940_dev_record_commit(&mcp7940_device, (data))
+        #define mcp7940_record_restore(data)                    mcp7940_dev_record_restore(&mcp7940_device, (data))
+    #endif
+
+    #ifdef MCP7940_CALIBRATION_EN
+        #define mcp7940_calibration_begin(reference)            mcp7940_dev_calibration_begin(&mcp7940_device, (reference))
+        #define mcp7940_calibration_end(reference, ppm)         mcp7940_dev_calibration_end(&mcp7940_device, (reference), (ppm))
+        #define mcp7940_calibration_restore()                   mcp7940_dev_calibration_restore(&mcp7940_device)
+    #endif
+
+    #ifdef MCP7940_QUEUE_EN
+        #define mcp7940_queue_read(address, data, length)       mcp7940_dev_queue_read(&mcp7940_device, (address), (data), (length))
+        #define mcp7940_queue_write(address, data, length)      mcp7940_dev_queue_write(&mcp7940_device, (address), (data), (length))
+        #define mcp7940_queue_status(status)                    mcp7940_dev_queue_status(&mcp7940_device, (status))
+        #define mcp7940_queue_datetime(datetime)                mcp7940_dev_queue_datetime(&mcp7940_device, (datetime))
+        #define mcp7940_queue_flush(transactions)               mcp7940_dev_queue_flush(&mcp7940_device, (transactions))
+    #endif
+
+    #ifdef MCP7940_TICK_EN
+        #define mcp7940_tick_sync()                             mcp7940_dev_tick_sync(&mcp7940_device)
+        #define mcp7940_tick_interrupt()                        mcp7940_dev_tick_interrupt(&mcp7940_device)
+
+        #ifdef MCP7940_TICK_MS
+            #define mcp7940_tick_timestamp(datetime, millisecond)   mcp7940_dev_tick_timestamp(&mcp7940_device, (datetime), (millisecond))
+        #endif
+    #endif
+
+    #ifdef MCP7940_ASYNC_EN
+        #define mcp7940_datetime_async(datetime, callback)                  mcp7940_dev_datetime_async(&mcp7940_device, (datetime), (callback))
+        #define mcp7940_settime_async(time, callback)                       mcp7940_dev_settime_async(&mcp7940_device, (time), (callback))
+        #define mcp7940_setdate_async(date, callback)                       mcp7940_dev_setdate_async(&mcp7940_device, (date), (callback))
+        #define mcp7940_sram_read_async(offset, data, length, callback)     mcp7940_dev_sram_read_async(&mcp7940_device, (offset), (data), (length), (callback))
+        #define mcp7940_sram_write_async(offset, data, length, callback)    mcp7940_dev_sram_write_async(&mcp7940_device, (offset), (data), (length), (callback))
+    #endif
 
 #endif /* MCP7940_H_ */
\ No newline at end of file
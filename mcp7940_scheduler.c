@@ -0,0 +1,366 @@
+/**
+ * @file mcp7940_scheduler.c
+ *
+ * @brief Implementation of the MCP7940 software alarm scheduler.
+ *
+ * This file contains the implementation of a min-heap based scheduler that always programs the nearest pending deadline into the hardware alarm ALM0 of the MCP7940. The firmware can sleep until the MFP pin signals the alarm instead of polling the RTC.
+ *
+ * @author g.raf
+ * @date 2026-10-14
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/drivers-rtc-mcp7940 "MCP7940 RTC driver library"
+ */
+
+#include "mcp7940_scheduler.h"
+
+typedef struct
+{
+    FORMAT_DateTime deadline;
+    MCP7940_Scheduler_Callback callback;
+    unsigned char id;
+} MCP7940_Scheduler_Entry;
+
+static MCP7940_Scheduler_Entry mcp7940_scheduler_heap[MCP7940_SCHEDULER_SIZE];
+static unsigned char mcp7940_scheduler_size;
+static unsigned char mcp7940_scheduler_id;
+static volatile unsigned char mcp7940_scheduler_flag;
+
+static signed char mcp7940_scheduler_compare(const FORMAT_DateTime *a, const FORMAT_DateTime *b)
+{
+    const unsigned char left[]  = { a->date.year, a->date.month, a->date.day, a->time.hour, a->time.minute, a->time.second };
+    const unsigned char right[] = { b->date.year, b->date.month, b->date.day, b->time.hour, b->time.minute, b->time.second };
+
+    for(unsigned char i = 0; i < sizeof(left); i++)
+    {
+        if(left[i] != right[i])
+        {
+            return (left[i] < right[i]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static unsigned int mcp7940_scheduler_days(const FORMAT_Date *date)
+{
+    static const unsigned int elapsed[] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+    // Days since 01.01.2000, every year divisible by 4 is a leap year in 2000 to 2099
+    unsigned int days = ((date->year * 365U) + ((date->year + 3U) >> 2) + elapsed[date->month - 1] + (date->day - 1));
+
+    if((date->month > 2) && !(date->year & 0x03))
+    {
+        days++;
+    }
+    return days;
+}
+
+static MCP7940_Error mcp7940_scheduler_weekday(const MCP7940_Snapshot *snapshot, const FORMAT_DateTime *now, const FORMAT_DateTime *deadline, unsigned char *weekday)
+{
+    unsigned int today = mcp7940_scheduler_days(&now->date);
+    unsigned char current = mcp7940_snapshot_weekday(snapshot);
+
+    // A full match cannot be programmed against an uninitialized counter, it is set like mcp7940_setepoch() does (01.01.2000 was a saturday)
+    if(!current)
+    {
+        current = (unsigned char)((today + MCP7940_WEEKDAY_SATURDAY_gc) % 7);
+
+        MCP7940_Error error = mcp7940_setweekday(current);
+
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+        current++;
+    }
+
+    // Relative to the weekday counter of the device, so the alarm matches whatever weekday convention the application uses
+    *weekday = (unsigned char)(((current - 1) + (mcp7940_scheduler_days(&deadline->date) - today)) % 7);
+
+    return MCP7940_Error_None;
+}
+
+static unsigned char mcp7940_scheduler_before(unsigned char a, unsigned char b)
+{
+    return (mcp7940_scheduler_compare(&mcp7940_scheduler_heap[a].deadline, &mcp7940_scheduler_heap[b].deadline) < 0);
+}
+
+static void mcp7940_scheduler_swap(unsigned char a, unsigned char b)
+{
+    MCP7940_Scheduler_Entry temp = mcp7940_scheduler_heap[a];
+
+    mcp7940_scheduler_heap[a] = mcp7940_scheduler_heap[b];
+    mcp7940_scheduler_heap[b] = temp;
+}
+
+static void mcp7940_scheduler_up(unsigned char index)
+{
+    while(index)
+    {
+        unsigned char parent = ((index - 1) >> 1);
+
+        if(!mcp7940_scheduler_before(index, parent))
+        {
+            return;
+        }
+        mcp7940_scheduler_swap(index, parent);
+        index = parent;
+    }
+}
+
+static void mcp7940_scheduler_down(unsigned char index)
+{
+    for(;;)
+    {
+        unsigned char child = ((index << 1) + 1);
+        unsigned char temp  = index;
+
+        if((child < mcp7940_scheduler_size) && mcp7940_scheduler_before(child, temp))
+        {
+            temp = child;
+        }
+        if(((child + 1) < mcp7940_scheduler_size) && mcp7940_scheduler_before((child + 1), temp))
+        {
+            temp = (child + 1);
+        }
+        if(temp == index)
+        {
+            return;
+        }
+        mcp7940_scheduler_swap(index, temp);
+        index = temp;
+    }
+}
+
+static void mcp7940_scheduler_remove(unsigned char index)
+{
+    mcp7940_scheduler_size--;
+
+    if(index == mcp7940_scheduler_size)
+    {
+        return;
+    }
+    mcp7940_scheduler_heap[index] = mcp7940_scheduler_heap[mcp7940_scheduler_size];
+
+    mcp7940_scheduler_up(index);
+    mcp7940_scheduler_down(index);
+}
+
+static unsigned char mcp7940_scheduler_find(unsigned char id)
+{
+    for(unsigned char i = 0; i < mcp7940_scheduler_size; i++)
+    {
+        if(mcp7940_scheduler_heap[i].id == id)
+        {
+            return i;
+        }
+    }
+    return MCP7940_SCHEDULER_SIZE;
+}
+
+/**
+ * @brief Initializes the MCP7940 alarm scheduler and discards all pending deadlines.
+ *
+ * @details
+ * This function resets the internal heap and disables the hardware alarm ALM0. It should be called once after mcp7940_init(), before deadlines are added. The MFP pin has to be configured for alarm output (@c MCP7940_MFP_MODE set to @c MCP7940_MFP_MODE_ALARM) and its interrupt routed to mcp7940_scheduler_interrupt().
+ */
+void mcp7940_scheduler_init(void)
+{
+    mcp7940_scheduler_size = 0;
+    mcp7940_scheduler_flag = 0;
+
+    mcp7940_alarm_enable(MCP7940_Alarm_0, MCP7940_Mode_Disable);
+}
+
+/**
+ * @brief Adds a deadline to the MCP7940 alarm scheduler.
+ *
+ * @param deadline Pointer to a ::FORMAT_DateTime structure with the point in time at which @p callback should be called.
+ *
+ * @param callback Function that is called from mcp7940_scheduler_process() once @p deadline has been reached.
+ *
+ * @param id Optional pointer (may be NULL) that receives the identifier of the new deadline, which can be passed to mcp7940_scheduler_cancel().
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the deadline was added.
+ * - `MCP7940_Error_Fail` if @p deadline is NULL or invalid, @p callback is NULL or the scheduler already holds @c MCP7940_SCHEDULER_SIZE deadlines.
+ *
+ * @details
+ * The deadline is inserted into the min-heap without any bus access. If it becomes the nearest deadline, the scheduler is marked for re-arming, so that the next call of mcp7940_scheduler_process() programs it into ALM0. Deadlines that are already in the past are reported by that call as well.
+ */
+MCP7940_Error mcp7940_scheduler_add(const FORMAT_DateTime *deadline, MCP7940_Scheduler_Callback callback, unsigned char *id)
+{
+    if(!deadline || !callback || (mcp7940_scheduler_size >= MCP7940_SCHEDULER_SIZE) || (validate_time(&deadline->time) != RETURN_Valid) || (validate_date(&deadline->date) != RETURN_Valid))
+    {
+        return MCP7940_Error_Fail;
+    }
+
+    // Identifiers are unique as long as fewer than 256 deadlines are pending
+    do
+    {
+        mcp7940_scheduler_id++;
+    } while(mcp7940_scheduler_find(mcp7940_scheduler_id) != MCP7940_SCHEDULER_SIZE);
+
+    unsigned char index = mcp7940_scheduler_size++;
+
+    mcp7940_scheduler_heap[index].deadline = *deadline;
+    mcp7940_scheduler_heap[index].callback = callback;
+    mcp7940_scheduler_heap[index].id = mcp7940_scheduler_id;
+
+    mcp7940_scheduler_up(index);
+
+    if(mcp7940_scheduler_heap[0].id == mcp7940_scheduler_id)
+    {
+        mcp7940_scheduler_flag = 1;
+    }
+
+    if(id)
+    {
+        *id = mcp7940_scheduler_id;
+    }
+    return MCP7940_Error_None;
+}
+
+/**
+ * @brief Removes a pending deadline from the MCP7940 alarm scheduler.
+ *
+ * @param id Identifier of the deadline as returned by mcp7940_scheduler_add().
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the deadline was removed.
+ * - `MCP7940_Error_Fail` if no pending deadline with @p id exists (e.g. it already expired).
+ *
+ * @details
+ * If the nearest deadline is removed, the scheduler is marked for re-arming so that the next call of mcp7940_scheduler_process() programs the following deadline into ALM0.
+ */
+MCP7940_Error mcp7940_scheduler_cancel(unsigned char id)
+{
+    unsigned char index = mcp7940_scheduler_find(id);
+
+    if(index == MCP7940_SCHEDULER_SIZE)
+    {
+        return MCP7940_Error_Fail;
+    }
+
+    if(!index)
+    {
+        mcp7940_scheduler_flag = 1;
+    }
+    mcp7940_scheduler_remove(index);
+
+    return MCP7940_Error_None;
+}
+
+/**
+ * @brief Returns the number of pending deadlines in the MCP7940 alarm scheduler.
+ *
+ * @return Number of deadlines that have been added and neither expired nor been cancelled.
+ */
+unsigned char mcp7940_scheduler_count(void)
+{
+    return mcp7940_scheduler_size;
+}
+
+/**
+ * @brief Signals the MCP7940 alarm scheduler that the MFP pin has been asserted.
+ *
+ * @details
+ * This function only sets a flag and does not access the bus, so it can be called directly from the interrupt service routine of the pin the MFP output is connected to. The actual handling is performed by mcp7940_scheduler_process() from the main loop.
+ */
+void mcp7940_scheduler_interrupt(void)
+{
+    mcp7940_scheduler_flag = 1;
+}
+
+/**
+ * @brief Checks whether the MCP7940 alarm scheduler requires a call of mcp7940_scheduler_process().
+ *
+ * @return Non-zero if an alarm interrupt has been signalled or a new nearest deadline has to be programmed, otherwise 0.
+ *
+ * @details
+ * The main loop can use this function to decide whether it may enter sleep mode or has to process the scheduler first.
+ */
+unsigned char mcp7940_scheduler_pending(void)
+{
+    return mcp7940_scheduler_flag;
+}
+
+/**
+ * @brief Calls all expired deadlines and programs the nearest remaining one into ALM0.
+ *
+ * @return Number of callbacks that have been called.
+ *
+ * @details
+ * If neither an interrupt has been signalled with mcp7940_scheduler_interrupt() nor the nearest deadline changed, the function returns immediately without a bus access. Otherwise it clears the ALM0 interrupt flag, reads a tear-free register snapshot with mcp7940_snapshot_atomic() and calls (and removes) every deadline that is not later than the current time. The nearest remaining deadline is then programmed into ALM0 with a full match (second, minute, hour, weekday, date and month), or ALM0 is disabled if no deadline is left, so the MFP pin is asserted exactly once per deadline. The weekday of the deadline is derived from the weekday register of the same snapshot and the number of days up to the deadline, so a rollover at midnight between the reads cannot arm a weekday that never matches. An uninitialized weekday counter (0) is set from the calendar first, with Monday as @c MCP7940_WEEKDAY_MONDAY_gc like mcp7940_setepoch(). The time is read once more after programming, so a deadline that was reached in the meantime is not missed. If a bus access fails, the scheduler stays marked, so the next call repeats the processing. Since the year is not part of the match, a deadline one year or more ahead causes an interrupt on the same date of an earlier year with the matching weekday, which is detected here and simply leads to re-arming the same deadline. Callbacks may add or cancel deadlines.
+ */
+unsigned char mcp7940_scheduler_process(void)
+{
+    if(!mcp7940_scheduler_flag)
+    {
+        return 0;
+    }
+    mcp7940_scheduler_flag = 0;
+
+    MCP7940_Snapshot snapshot;
+    FORMAT_DateTime now;
+
+    // Date and weekday from the same tear-free read, so a rollover at midnight cannot mix two days
+    if((mcp7940_alarm_clear(MCP7940_Alarm_0) != MCP7940_Error_None) || (mcp7940_snapshot_atomic(&snapshot) != MCP7940_Error_None))
+    {
+        mcp7940_scheduler_flag = 1;
+        return 0;
+    }
+    mcp7940_snapshot_datetime(&snapshot, &now);
+
+    unsigned char count = 0;
+
+    while(mcp7940_scheduler_size && (mcp7940_scheduler_compare(&mcp7940_scheduler_heap[0].deadline, &now) <= 0))
+    {
+        MCP7940_Scheduler_Entry entry = mcp7940_scheduler_heap[0];
+
+        mcp7940_scheduler_remove(0);
+        entry.callback(entry.id);
+        count++;
+    }
+
+    MCP7940_Error error;
+
+    if(!mcp7940_scheduler_size)
+    {
+        error = mcp7940_alarm_enable(MCP7940_Alarm_0, MCP7940_Mode_Disable);
+    }
+    else
+    {
+        unsigned char weekday;
+
+        error = mcp7940_scheduler_weekday(&snapshot, &now, &mcp7940_scheduler_heap[0].deadline, &weekday);
+
+        if(error == MCP7940_Error_None)
+        {
+            error = mcp7940_alarm_set(MCP7940_Alarm_0, &mcp7940_scheduler_heap[0].deadline, weekday, MCP7940_Match_Full);
+        }
+    }
+
+    // A deadline that was reached while ALM0 was programmed is not matched anymore, so it is handled by the next call
+    if((error == MCP7940_Error_None) && mcp7940_scheduler_size)
+    {
+        error = mcp7940_datetime_atomic(&now);
+
+        if((error == MCP7940_Error_None) && (mcp7940_scheduler_compare(&mcp7940_scheduler_heap[0].deadline, &now) <= 0))
+        {
+            mcp7940_scheduler_flag = 1;
+        }
+    }
+
+    // A failed bus access is repeated by the next call
+    if(error != MCP7940_Error_None)
+    {
+        mcp7940_scheduler_flag = 1;
+    }
+    return count;
+}
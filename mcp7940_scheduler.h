@@ -0,0 +1,53 @@
+/**
+ * @file mcp7940_scheduler.h
+ * @brief Header file with declarations and macros for the MCP7940 software alarm scheduler.
+ *
+ * This file provides function prototypes, type definitions, and constants for multiplexing an arbitrary number of wakeup deadlines onto the hardware alarm ALM0 of an mcp7940 rtc chip.
+ *
+ * @author g.raf
+ * @date 2026-10-14
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/drivers-rtc-mcp7940 "MCP7940 RTC driver library"
+ */
+
+#ifndef MCP7940_SCHEDULER_H_
+#define MCP7940_SCHEDULER_H_
+
+    #ifndef MCP7940_SCHEDULER_SIZE
+        /**
+         * @def MCP7940_SCHEDULER_SIZE
+         * @brief Maximum number of deadlines that can be pending in the MCP7940 alarm scheduler.
+         *
+         * The scheduler keeps all pending deadlines in a statically allocated min-heap of this size, so adding and removing a deadline costs O(log n) comparisons and no dynamic memory is used.
+         *
+         * @note If MCP7940_SCHEDULER_SIZE is not explicitly defined in the project configuration, it defaults to 16 entries.
+         */
+        #define MCP7940_SCHEDULER_SIZE 16
+    #endif
+
+    #include "mcp7940.h"
+
+    /**
+     * @typedef MCP7940_Scheduler_Callback
+     * @brief Function that is called by mcp7940_scheduler_process() when a deadline has been reached.
+     *
+     * @param id Identifier of the expired deadline as returned by mcp7940_scheduler_add().
+     */
+    typedef void (*MCP7940_Scheduler_Callback)(unsigned char id);
+
+                 void mcp7940_scheduler_init(void);
+        MCP7940_Error mcp7940_scheduler_add(const FORMAT_DateTime *deadline, MCP7940_Scheduler_Callback callback, unsigned char *id);
+        MCP7940_Error mcp7940_scheduler_cancel(unsigned char id);
+        unsigned char mcp7940_scheduler_count(void);
+
+                 void mcp7940_scheduler_interrupt(void);
+        unsigned char mcp7940_scheduler_pending(void);
+        unsigned char mcp7940_scheduler_process(void);
+
+#endif /* MCP7940_SCHEDULER_H_ */
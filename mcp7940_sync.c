@@ -0,0 +1,186 @@
+/**
+ * @file mcp7940_sync.c
+ *
+ * @brief Implementation of the MCP7940 time synchronization service.
+ *
+ * This file contains the implementation of a service that compares the MCP7940 with an external reference time and removes the offset either by slewing the oscillator through the OSCTRIM register or, for large offsets, by stepping the timekeeping registers. A regular update therefore neither causes a jump of the time nor rewrites the time registers.
+ *
+ * @author g.raf
+ * @date 2026-10-14
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/drivers-rtc-mcp7940 "MCP7940 RTC driver library"
+ */
+
+#include "mcp7940_sync.h"
+
+#if (MCP7940_SYNC_STEP < 0) || (MCP7940_SYNC_STEP > 2000)
+    #error "MCP7940 sync step threshold out of range (check MCP7940_SYNC_STEP)"
+#endif
+
+#if (MCP7940_SYNC_SLEW < 1)
+    #error "MCP7940 sync slew time out of range (check MCP7940_SYNC_SLEW)"
+#endif
+
+// One fine trim step adds or subtracts 2 clock cycles per minute, so removing one second per second takes 1000000 * 1966080 / 2000000 steps
+#define MCP7940_SYNC_SCALE 983040L
+
+static MCP7940_Sync_Statistics mcp7940_sync_state;
+static unsigned char mcp7940_sync_coarse;
+
+static signed char mcp7940_sync_decode(unsigned char value)
+{
+    return (value & 0x80) ? (signed char)(value & 0x7F) : -(signed char)(value & 0x7F);
+}
+
+static void mcp7940_sync_record(long offset)
+{
+    for(unsigned char i = (MCP7940_SYNC_HISTORY - 1); i; i--)
+    {
+        mcp7940_sync_state.offset[i] = mcp7940_sync_state.offset[i - 1];
+    }
+    mcp7940_sync_state.offset[0] = offset;
+
+    if(mcp7940_sync_state.count < MCP7940_SYNC_HISTORY)
+    {
+        mcp7940_sync_state.count++;
+    }
+}
+
+static signed char mcp7940_sync_target(long offset)
+{
+    long steps = (offset * MCP7940_SYNC_SCALE);
+    long divisor = MCP7940_SYNC_SLEW;
+
+    // A coarse step is applied 128 times per second instead of once per minute and equals MCP7940_CALIBRATION_COARSE fine steps
+    if(mcp7940_sync_coarse)
+    {
+        divisor *= MCP7940_CALIBRATION_COARSE;
+    }
+
+    // Rounded to the nearest step
+    steps = ((steps < 0) ? (steps - (divisor / 2)) : (steps + (divisor / 2))) / divisor;
+
+    // An RTC that is ahead has to run slower, so clocks are subtracted
+    steps = (mcp7940_sync_state.base - steps);
+
+    if(steps > 127L)
+    {
+        return 127;
+    }
+    else if(steps < -127L)
+    {
+        return -127;
+    }
+    return (signed char)steps;
+}
+
+/**
+ * @brief Initializes the MCP7940 time synchronization service and clears its statistics.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the trim in effect has been read.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if the register snapshot failed on the bus.
+ *
+ * @details
+ * This function should be called once after mcp7940_init() (and a calibration restored or measured by mcp7940_calibration_restore() or mcp7940_calibration_end(), if used). The OSCTRIM value and the CSTRIM bit are taken from one register snapshot. The trim becomes the base to which mcp7940_sync_update() returns once the offset is removed, so a calibration of the oscillator frequency is preserved.
+ */
+MCP7940_Error mcp7940_sync_init(void)
+{
+    MCP7940_Snapshot snapshot;
+    MCP7940_Error error = mcp7940_snapshot(&snapshot);
+
+    mcp7940_sync_state = (MCP7940_Sync_Statistics){ 0 };
+
+    if(error != MCP7940_Error_None)
+    {
+        return error;
+    }
+    mcp7940_sync_coarse = (snapshot.data[MCP7940_CONTROL] & MCP7940_CSTRIM_bm);
+    mcp7940_sync_state.base = mcp7940_sync_decode(snapshot.data[MCP7940_OSCTRIM]);
+    mcp7940_sync_state.trim = mcp7940_sync_state.base;
+
+    return MCP7940_Error_None;
+}
+
+/**
+ * @brief Compares the MCP7940 with a reference time and corrects the offset.
+ *
+ * @param reference Reference time in seconds since 01.01.1970 00:00:00 (e.g. the seconds of an NTP timestamp converted to the Unix epoch). Valid values range from @c MCP7940_EPOCH_OFFSET to @c MCP7940_EPOCH_LIMIT.
+ *
+ * @return Returns one of the following error codes:
+ * - `MCP7940_Error_None` if the offset was measured and the correction applied.
+ * - `MCP7940_Error_Fail` if @p reference is out of range (no bus access is performed), the RTC time could not be read consistently, or the trim could not be verified.
+ * - `MCP7940_Error_Nack`, `MCP7940_Error_Timeout` or `MCP7940_Error_Arbitration` if a transaction failed on the bus.
+ *
+ * @details
+ * The offset (RTC minus reference) is read with mcp7940_epoch() and recorded in the statistics. If its absolute value exceeds @c MCP7940_SYNC_STEP, the RTC is stepped to @p reference with mcp7940_setepoch() and the trim returns to the base. Otherwise the trim is set to the base minus a correction that removes the offset over @c MCP7940_SYNC_SLEW seconds, limited to the 127 steps of the OSCTRIM register. mcp7940_trimming() is only called if the trim changes, so an update of an RTC in step costs the two read transactions of mcp7940_epoch() instead of the stop, poll and burst sequence of mcp7940_setdatetime().
+ *
+ * The offset is measured with a resolution of one second, hence the correction is applied until the RTC is within one second of the reference. Updates in regular intervals well below @c MCP7940_SYNC_SLEW keep the correction close to the remaining offset.
+ */
+MCP7940_Error mcp7940_sync_update(unsigned long reference)
+{
+    if((reference < MCP7940_EPOCH_OFFSET) || (reference >= MCP7940_EPOCH_LIMIT))
+    {
+        return MCP7940_Error_Fail;
+    }
+
+    unsigned long epoch;
+    MCP7940_Error error = mcp7940_epoch(&epoch);
+
+    if(error != MCP7940_Error_None)
+    {
+        return error;
+    }
+
+    long offset = (long)(epoch - reference);
+
+    mcp7940_sync_record(offset);
+
+    if((offset > MCP7940_SYNC_STEP) || (offset < -MCP7940_SYNC_STEP))
+    {
+        error = mcp7940_setepoch(reference);
+
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+        mcp7940_sync_state.steps++;
+        offset = 0;
+    }
+
+    signed char trim = mcp7940_sync_target(offset);
+
+    if(trim != mcp7940_sync_state.trim)
+    {
+        error = mcp7940_trimming(((trim < 0) ? MCP7940_Trim_Substract : MCP7940_Trim_Add), (unsigned char)((trim < 0) ? -trim : trim));
+
+        if(error != MCP7940_Error_None)
+        {
+            return error;
+        }
+        mcp7940_sync_state.trims++;
+        mcp7940_sync_state.trim = trim;
+    }
+    mcp7940_sync_state.updates++;
+
+    return MCP7940_Error_None;
+}
+
+/**
+ * @brief Copies the state and statistics of the MCP7940 time synchronization service.
+ *
+ * @param statistics Pointer to a ::MCP7940_Sync_Statistics structure that receives the offset history, the update, step and trim counters and the trim in effect.
+ *
+ * @details
+ * No bus access is performed. A steadily growing offset in the history between updates indicates a frequency error that should be corrected once with mcp7940_calibration_begin() and mcp7940_calibration_end(), so the slewing only has to remove the residual offset.
+ */
+void mcp7940_sync_statistics(MCP7940_Sync_Statistics *statistics)
+{
+    *statistics = mcp7940_sync_state;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file mcp7940_sync.h
+ * @brief Header file with declarations and macros for the MCP7940 time synchronization service.
+ *
+ * This file provides function prototypes, type definitions, and constants for keeping an mcp7940 rtc chip in step with an external reference time (e.g. NTP or GNSS). Small offsets are removed by slewing the oscillator with the digital trimming, only large offsets step the timekeeping registers.
+ *
+ * @author g.raf
+ * @date 2026-10-14
+ * @version 1.0 Release
+ * @copyright
+ * Copyright (c) 2026 g.raf
+ * Released under the GPLv3 License. (see LICENSE in repository)
+ *
+ * @note This file is part of a larger project and subject to the license specified in the repository. For updates and the complete revision history, see the GitHub repository.
+ *
+ * @see https://github.com/0x007e/drivers-rtc-mcp7940 "MCP7940 RTC driver library"
+ */
+
+#ifndef MCP7940_SYNC_H_
+#define MCP7940_SYNC_H_
+
+    #ifndef MCP7940_SYNC_STEP
+        /**
+         * @def MCP7940_SYNC_STEP
+         * @brief Offset in seconds above which mcp7940_sync_update() steps the RTC instead of slewing it.
+         *
+         * Offsets with an absolute value up to this threshold are removed by the digital trimming without a discontinuity of the time. Larger offsets (e.g. after a power failure without battery) are corrected at once with mcp7940_setepoch().
+         *
+         * @note If MCP7940_SYNC_STEP is not explicitly defined in the project configuration, it defaults to 2 seconds.
+         */
+        #define MCP7940_SYNC_STEP 2L
+    #endif
+
+    #ifndef MCP7940_SYNC_SLEW
+        /**
+         * @def MCP7940_SYNC_SLEW
+         * @brief Time in seconds over which mcp7940_sync_update() intends to remove an offset by slewing.
+         *
+         * The trim correction is proportional to the offset divided by this time. One fine trim step corresponds to about 1.017 ppm, so the default removes an offset of one second with 11 steps, and the maximum correction of 127 steps removes about 0.11 seconds per day.
+         *
+         * @note If MCP7940_SYNC_SLEW is not explicitly defined in the project configuration, it defaults to 86400 seconds (one day).
+         */
+        #define MCP7940_SYNC_SLEW 86400L
+    #endif
+
+    #ifndef MCP7940_SYNC_HISTORY
+        /**
+         * @def MCP7940_SYNC_HISTORY
+         * @brief Number of measured offsets that are kept in ::MCP7940_Sync_Statistics.
+         *
+         * @note If MCP7940_SYNC_HISTORY is not explicitly defined in the project configuration, it defaults to 8 entries.
+         */
+        #define MCP7940_SYNC_HISTORY 8
+    #endif
+
+    #include "mcp7940.h"
+
+    /**
+     * @struct MCP7940_Sync_Statistics_t
+     * @brief State and statistics of the MCP7940 time synchronization service.
+     */
+    struct MCP7940_Sync_Statistics_t
+    {
+        long offset[MCP7940_SYNC_HISTORY];  /**< Measured offsets in seconds (RTC minus reference), index 0 is the latest */
+        unsigned char count;                /**< Number of valid entries in @c offset */
+        unsigned int updates;               /**< Number of successful calls of mcp7940_sync_update() */
+        unsigned int steps;                 /**< Number of updates that stepped the RTC */
+        unsigned int trims;                 /**< Number of updates that wrote the OSCTRIM register */
+        signed char base;                   /**< Trim that was in effect at mcp7940_sync_init() (e.g. a calibration), positive adds clocks */
+        signed char trim;                   /**< Trim currently in effect, positive adds clocks */
+    };
+    /**
+     * @typedef MCP7940_Sync_Statistics
+     * @brief Alias for struct MCP7940_Sync_Statistics_t.
+     */
+    typedef struct MCP7940_Sync_Statistics_t MCP7940_Sync_Statistics;
+
+        MCP7940_Error mcp7940_sync_init(void);
+        MCP7940_Error mcp7940_sync_update(unsigned long reference);
+                 void mcp7940_sync_statistics(MCP7940_Sync_Statistics *statistics);
+
+#endif /* MCP7940_SYNC_H_ */